@@ -25,6 +25,7 @@
 #include "commands/installremove.h"
 #include "commands/sourceinstall.h"
 #include "commands/distupgrade.h"
+#include "commands/applyplan.h"
 #include "commands/inrverify.h"
 #include "commands/patch.h"
 #include "commands/update.h"
@@ -134,6 +135,7 @@ namespace
       makeCmd<ListPatchesCmd> ( ZypperCommand::LIST_PATCHES_e , std::string(), { "list-patches", "lp" } ),
       makeCmd<DistUpgradeCmd> ( ZypperCommand::DIST_UPGRADE_e , std::string(), { "dist-upgrade", "dup" } ),
       makeCmd<PatchCheckCmd> ( ZypperCommand::PATCH_CHECK_e , std::string(), { "patch-check", "pchk"} ),
+      makeCmd<ApplyPlanCmd> ( ZypperCommand::APPLY_PLAN_e , std::string(), { "apply-plan" } ),
 
       makeCmd<SearchCmd> ( ZypperCommand::SEARCH_e , _("Querying:"), { "search", "se" } ),
       makeCmd<InfoCmd> ( ZypperCommand::INFO_e , std::string(), { "info", "if" } ),
@@ -222,6 +224,7 @@ DEF_ZYPPER_COMMAND( PATCH );
 DEF_ZYPPER_COMMAND( LIST_PATCHES );
 DEF_ZYPPER_COMMAND( PATCH_CHECK );
 DEF_ZYPPER_COMMAND( DIST_UPGRADE );
+DEF_ZYPPER_COMMAND( APPLY_PLAN );
 
 DEF_ZYPPER_COMMAND( SEARCH );
 DEF_ZYPPER_COMMAND( INFO );
@@ -50,6 +50,7 @@ struct ZypperCommand
   static const ZypperCommand LIST_PATCHES;
   static const ZypperCommand PATCH_CHECK;
   static const ZypperCommand DIST_UPGRADE;
+  static const ZypperCommand APPLY_PLAN;
 
   static const ZypperCommand SEARCH;
   static const ZypperCommand INFO;
@@ -126,6 +127,7 @@ struct ZypperCommand
     LIST_PATCHES_e,
     PATCH_CHECK_e,
     DIST_UPGRADE_e,
+    APPLY_PLAN_e,
 
     SEARCH_e,
     INFO_e,
@@ -19,9 +19,12 @@ extern "C"
 
 #include "utils/messages.h"
 #include "utils/Augeas.h"
+#include "utils/PhaseProfile.h"
+#include "utils/TraceFile.h"
 #include "utils/flags/flagtypes.h"
 #include "output/OutNormal.h"
 #include "output/OutXML.h"
+#include "output/OutJSON.h"
 #include "Config.h"
 #include "global-settings.h"
 #include "Zypper.h"
@@ -153,6 +156,7 @@ namespace
   enum class ConfigOption {
     MAIN_SHOW_ALIAS,
     MAIN_REPO_LIST_COLUMNS,
+    MAIN_QUERY_RESULT_CACHE,
 
     SOLVER_INSTALL_RECOMMENDS,
     SOLVER_FORCE_RESOLUTION_COMMANDS,
@@ -188,6 +192,7 @@ namespace
     static const std::vector<std::pair<std::string,ConfigOption>> _data = {
       { "main/showAlias",			ConfigOption::MAIN_SHOW_ALIAS			},
       { "main/repoListColumns",			ConfigOption::MAIN_REPO_LIST_COLUMNS		},
+      { "main/queryResultCache",		ConfigOption::MAIN_QUERY_RESULT_CACHE		},
       { "solver/installRecommends",		ConfigOption::SOLVER_INSTALL_RECOMMENDS		},
       { "solver/forceResolutionCommands",	ConfigOption::SOLVER_FORCE_RESOLUTION_COMMANDS	},
 
@@ -264,6 +269,7 @@ namespace
 
 Config::Config()
   : repo_list_columns("anr")
+  , queryResultCache(true)
   , solver_installRecommends(!ZConfig::instance().solver_onlyRequires())
   , psCheckAccessDeleted(true)
   , do_ttyout		(mayUseANSIEscapes())
@@ -447,6 +453,17 @@ std::vector<ZyppFlags::CommandGroup> Config::cliOptions()
               _("Switch to XML output.")
           ).setPriority( Priority::OUTPUT )
         ),
+        std::move( ZyppFlags::CommandOption(
+          "jsonout", 0, ZyppFlags::NoArgument, ZyppFlags::CallbackVal( [ this ]( const ZyppFlags::CommandOption &, const boost::optional<std::string> & ) {
+                do_colors = false;	// no color in json mode!
+                Zypper::instance().setOutputWriter( new OutJSON( verbosity ) );
+                machine_readable = true;
+                no_abbrev = true;
+              }),
+              // translators: --jsonout
+              _("Switch to JSON Lines output (the XML output as one JSON object per line).")
+          ).setPriority( Priority::OUTPUT )
+        ),
         { "ignore-unknown", 'i', ZyppFlags::NoArgument, ZyppFlags::BoolType( &ignore_unknown, ZyppFlags::StoreTrue, ignore_unknown ),
               // translators: --ignore-unknown, -i
               _("Ignore unknown packages.")
@@ -462,6 +479,21 @@ std::vector<ZyppFlags::CommandGroup> Config::cliOptions()
             // translators: --terse, -t
             _("Terse output for machine consumption. Implies --no-abbrev and --no-color.")
         },
+        { "profile", 0, ZyppFlags::NoArgument,
+            ZyppFlags::CallbackVal( []( const ZyppFlags::CommandOption &, const boost::optional<std::string> & ) {
+              PhaseProfile::instance().setEnabled();
+            }),
+            // translators: --profile
+            _("At exit print the time and resources used by each phase (like reading repositories, solving, downloading).")
+        },
+        { "trace-file", 0, ZyppFlags::RequiredArgument,
+            ZyppFlags::CallbackVal( []( const ZyppFlags::CommandOption &, const boost::optional<std::string> & val ) {
+              if ( val && ! TraceFile::instance().open( *val ) )
+                Zypper::instance().out().warning( str::Format(_("Unable to write the trace file '%1%'.")) % *val );
+            }, ARG_FILE ),
+            // translators: --trace-file <FILE>
+            _("Write a Chrome trace event file showing the phases, each repository refresh, download and rpm step on a timeline.")
+        },
         // -------------------- deprecated and hidden switches------------------------------------------
 
         // rug compatibility alias for the default output level => ignored
@@ -476,7 +508,9 @@ std::vector<ZyppFlags::CommandGroup> Config::cliOptions()
         //conflicting flags
         { "quiet", "verbose", "debug" },
         { "color", "no-color" },
-        { "color", "xmlout" } //color will always be disabled for XML
+        { "color", "xmlout" }, //color will always be disabled for XML
+        { "color", "jsonout" },
+        { "xmlout", "jsonout" }
       }
     } , {
       //start a new section of commands
@@ -672,6 +706,10 @@ void Config::read( const std::string & file )
     if (!s.empty()) // TODO add some validation
       repo_list_columns = s;
 
+    s = augeas.getOption(asString( ConfigOption::MAIN_QUERY_RESULT_CACHE ));
+    if ( ! s.empty() )
+      queryResultCache = str::strToBool( s, queryResultCache );
+
     // ---------------[ solver ]------------------------------------------------
 
     s = augeas.getOption(asString( ConfigOption::SOLVER_INSTALL_RECOMMENDS ));
@@ -36,6 +36,8 @@ struct Config
   /** Which columns to show in repo list by default (string of short options).*/
   std::string repo_list_columns;
 
+  bool queryResultCache;	///< replay lu/lp/pchk results if the system is unchanged?
+
   bool solver_installRecommends;
   std::set<ZypperCommand> solver_forceResolutionCommands;
 
@@ -23,6 +23,7 @@
 #include "Zypper.h"
 #include "SolverRequester.h"
 #include "global-settings.h"
+#include "utils/misc.h"
 
 // libzypp logger settings
 #undef  ZYPP_BASE_LOGGER_LOGGROUP
@@ -55,6 +56,16 @@ namespace
     }
   }
 
+  /** Names close to the requested one (plain names only, no globs). */
+  std::string getTypoHint( const PackageSpec & pkg_r )
+  {
+    sat::Solvable::SplitIdent splid( pkg_r.parsed_cap.detail().name() );
+    const std::string & name { splid.name().asString() };
+    if ( name.empty() || name.find_first_of( "?*[" ) != std::string::npos )
+      return std::string();
+    return similarNamesHint( name, splid.kind() );
+  }
+
   PoolQuery pkg_spec_to_poolquery( const Capability & cap, const std::list<std::string> & repos )
   {
     //
@@ -85,6 +96,19 @@ namespace
     return pkg_spec_to_poolquery( cap, repos );
   }
 
+  /** Whether \a pkg_r is a plain (kind:)name, which can be looked up in the pools
+   * ident index. Anything with globs, version, arch or repo needs a PoolQuery.
+   */
+  bool is_plain_name_spec( const PackageSpec & pkg_r, const std::list<std::string> & repos_r )
+  {
+    if ( ! pkg_r.repo_alias.empty() || ! repos_r.empty() )
+      return false;
+    const CapDetail & detail { pkg_r.parsed_cap.detail() };
+    if ( ! detail.isNamed() || detail.hasArch() )
+      return false;
+    return( detail.name().asString().find_first_of( "?*[\\" ) == std::string::npos );
+  }
+
   std::set<PoolItem> get_installed_providers( const Capability & cap )
   {
     std::set<PoolItem> providers;
@@ -222,16 +246,28 @@ void SolverRequester::install( const PackageSpec & pkg )
   // first try by name
   if ( !_opts.force_by_cap )
   {
-    PoolQuery q;
-    if ( !pkg.repo_alias.empty() )
-      q = pkg_spec_to_poolquery( pkg.parsed_cap, pkg.repo_alias );
-    else
-      q = pkg_spec_to_poolquery( pkg.parsed_cap, _opts.from_repos );
-
     // get the best matching items and tag them for installation.
     // FIXME this ignores vendor lock - we need some way to do --from which
     // would respect vendor lock: e.g. a new Selectable::updateCandidateObj(Options&)
-    PoolItemBest bestMatches( q.begin(), q.end(), PoolItemBest::preferNotLocked );
+    PoolItemBest bestMatches( PoolItemBest::preferNotLocked );
+    PoolQuery q;
+    bool plainName = is_plain_name_spec( pkg, _opts.from_repos );
+    if ( plainName )
+    {
+      // Hash lookup instead of a PoolQuery scanning the whole pool per argument
+      // (image builds pass thousands of plain names).
+      const ResPool & pool { ResPool::instance() };
+      sat::Solvable::SplitIdent splid( pkg.parsed_cap.detail().name() );
+      bestMatches.add( pool.byIdentBegin( splid.kind(), splid.name() ), pool.byIdentEnd( splid.kind(), splid.name() ) );
+    }
+    else
+    {
+      if ( !pkg.repo_alias.empty() )
+	q = pkg_spec_to_poolquery( pkg.parsed_cap, pkg.repo_alias );
+      else
+	q = pkg_spec_to_poolquery( pkg.parsed_cap, _opts.from_repos );
+      bestMatches.add( q.begin(), q.end() );
+    }
 
     if ( !bestMatches.empty() )
     {
@@ -306,13 +342,15 @@ void SolverRequester::install( const PackageSpec & pkg )
     }
     else if ( _opts.force_by_name || pkg.modified )
     {
-      addFeedback( Feedback::NOT_FOUND_NAME, pkg );
+      addFeedback( Feedback::NOT_FOUND_NAME, pkg, getTypoHint( pkg ) );
       WAR << pkg << " not found" << endl;
       return;
     }
 
     addFeedback( Feedback::NOT_FOUND_NAME_TRYING_CAPS, pkg );
     // Quick check whether there would have been matches with different case..
+    if ( plainName )
+      q = pkg_spec_to_poolquery( pkg.parsed_cap, _opts.from_repos );
     getCiMatchHint( q, ciMatchHint );
   }
 
@@ -321,6 +359,8 @@ void SolverRequester::install( const PackageSpec & pkg )
   sat::WhatProvides q( pkg.parsed_cap );
   if ( q.empty() )
   {
+    if ( ciMatchHint.empty() )
+      ciMatchHint = getTypoHint( pkg );
     addFeedback( Feedback::NOT_FOUND_CAP, pkg, ciMatchHint );
     WAR << pkg << " not found" << endl;
     return;
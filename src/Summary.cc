@@ -60,6 +60,8 @@ Summary::Summary( const ResPool & pool, const ViewOptions options )
 
 struct ResNameCompare
 {
+  typedef void is_transparent;	// lookup by name
+
   bool operator()( ResObject::constPtr r1, ResObject::constPtr r2 ) const
   {
     int ret = ::strcoll( r1->name().c_str(), r2->name().c_str() );
@@ -67,9 +69,14 @@ struct ResNameCompare
       return r1->edition() < r2->edition();
     return ret < 0;
   }
+  bool operator()( const ResObject::constPtr & r1, const char * name2 ) const
+  { return ::strcoll( r1->name().c_str(), name2 ) < 0; }
+  bool operator()( const char * name1, const ResObject::constPtr & r2 ) const
+  { return ::strcoll( name1, r2->name().c_str() ) < 0; }
 };
 
-typedef std::map<Resolvable::Kind, std::set<ResObject::constPtr, ResNameCompare> > KindToResObjectSet;
+typedef std::set<ResObject::constPtr, ResNameCompare> ResObjectSet;
+typedef std::map<Resolvable::Kind, ResObjectSet> KindToResObjectSet;
 
 // --------------------------------------------------------------------------
 
@@ -86,6 +93,7 @@ void Summary::readPool( const ResPool & pool )
   _inst_size_change = ByteCount();
 
   _ctc.clear();
+  _rowCells.clear();
 
   // find multi-version packages, which actually have mult. versions installed
   for ( const ui::Selectable::Ptr & s : sat::Pool::instance().multiversion().selectable() )
@@ -199,9 +207,12 @@ void Summary::readPool( const ResPool & pool )
 	}
       }
 
-      // find in to_be_removed:
+      // find in to_be_removed (lookup by name, the set is sorted by name):
       bool upgrade_downgrade = false;
-      for_( rmit, to_be_removed[res->kind()].begin(), to_be_removed[res->kind()].end() )
+      ResObjectSet & removed( to_be_removed[res->kind()] );
+      const std::string & name( res->name() );
+      for ( auto rmit = removed.lower_bound( name.c_str() );
+	    rmit != removed.end() && ::strcoll( (*rmit)->name().c_str(), name.c_str() ) == 0; ++rmit )
       {
         if ( res->name() == (*rmit)->name() )
         {
@@ -249,7 +260,7 @@ void Summary::readPool( const ResPool & pool )
           _inst_size_change += res->installSize() - (*rmit)->installSize();
 
           // this turned out to be an upgrade/downgrade
-          to_be_removed[res->kind()].erase( *rmit );
+          removed.erase( rmit );
           upgrade_downgrade = true;
           break;
         }
@@ -294,36 +305,44 @@ void Summary::readPool( const ResPool & pool )
 
   // get all available updates, no matter if they are installable or break
   // some current policy
+  // (Only selectables having an installed object matter, so we start at the
+  // installed items rather than iterating all selectables in the pool.)
   KindToResPairSet candidates;
   ResKindSet kinds;
   kinds.insert( ResKind::package );
   kinds.insert( ResKind::product );
-  for_( kit, kinds.begin(), kinds.end() )
+  std::set<ui::Selectable::Ptr> seen;
+  for ( const sat::Solvable & solv : sat::Pool::instance().findSystemRepo().solvables() )
   {
-    for_( it, pool.proxy().byKindBegin(*kit), pool.proxy().byKindEnd(*kit) )
-    {
-      if ( !(*it)->hasInstalledObj() )
-        continue;
+    if ( ! kinds.count( solv.kind() ) )
+      continue;
+    ui::Selectable::Ptr sel( ui::Selectable::get( solv ) );
+    if ( ! sel || ! seen.insert( sel ).second )
+      continue;
+    if ( !sel->hasInstalledObj() )
+      continue;
 
-      PoolItem candidate = (*it)->highestAvailableVersionObj();
+    PoolItem candidate = sel->highestAvailableVersionObj();
 
-      if ( !candidate )
-        continue;
-      if ( compareByNVRA( (*it)->installedObj(), candidate ) >= 0 )
-        continue;
-      // ignore higher versions with different arch (except noarch) bnc #646410
-      if ( (*it)->installedObj().arch() != candidate.arch()
-	&& (*it)->installedObj().arch() != Arch_noarch
-	&& candidate.arch() != Arch_noarch )
-	continue;
-      // mutliversion packages do not end up in _toupgrade, so we need to remove
-      // them from candidates if the candidate actually installs (bnc #629197)
-      if ( _multiInstalled.find( candidate.name() ) != _multiInstalled.end()
-	&& candidate.status().isToBeInstalled() )
-        continue;
+    if ( !candidate )
+      continue;
+    if ( compareByNVRA( sel->installedObj(), candidate ) >= 0 )
+      continue;
+    // ignore higher versions with different arch (except noarch) bnc #646410
+    if ( sel->installedObj().arch() != candidate.arch()
+      && sel->installedObj().arch() != Arch_noarch
+      && candidate.arch() != Arch_noarch )
+      continue;
+    // mutliversion packages do not end up in _toupgrade, so we need to remove
+    // them from candidates if the candidate actually installs (bnc #629197)
+    if ( _multiInstalled.find( candidate.name() ) != _multiInstalled.end()
+      && candidate.status().isToBeInstalled() )
+      continue;
 
-      candidates[*kit].insert( ResPair( nullptr, candidate.resolvable() ) );
-    }
+    candidates[sel->kind()].insert( ResPair( nullptr, candidate.resolvable() ) );
+  }
+  for_( kit, kinds.begin(), kinds.end() )
+  {
     MIL << *kit << " update candidates: " << candidates[*kit].size() << endl;
     MIL << "to be actually updated: " << _toupgrade[*kit].size() << endl;
   }
@@ -392,14 +411,14 @@ namespace
     return( withKind_r ? resp_r.second->ident().asString() : resp_r.second->name() );
   }
 
-  /** bsc#1061384: add hint if product is better updated by a different command
+  /** bsc#1061384: hint if product is better updated by a different command
    * Products buddy (the-release package) may provide some indicator telling that
    * a specific command should be used to update the product.
    * \code
    *   Provides product-update() == dup
    * \endcode
    */
-  inline void addUpdateHint( TableRow & tr_r, std::list<std::string> & ctc_r, ResObject::constPtr obj_r )
+  inline std::string updateHint( ResObject::constPtr obj_r )
   {
     if ( obj_r && obj_r->isKind<Product>() )
     {
@@ -410,20 +429,46 @@ namespace
 	if ( obj_r->asKind<Product>()->referencePackage().provides().matches( indicator ) )
 	{
 	  WAR << obj_r << " provides " << indicator << endl;
+	  // summary() for products like in ResPair2Name;
+	  // DEFAULTString to prevent the command string from being colored in MSG_WARNINGString
+	  //
 	  // translator: '%1%' is a products name
 	  //             '%2%' is a command to call (like 'zypper dup')
 	  //             Both may contain whitespace and should be enclosed by quotes!
-	  std::string ctcmsg( str::Format( _("Product '%1%' requires to be updated by calling '%2%'!") ) % obj_r->summary() % DEFAULTString("zypper dup") );
-	  // ^^^ summary() for products like in ResPair2Name
-	  //     DEFAULTString to prevent the command string from being colored in MSG_WARNINGString below
-	  tr_r.addDetail( MSG_WARNINGString( ctcmsg ) );
-	  ctc_r.push_back( std::move(ctcmsg) );
+	  return str::Format( _("Product '%1%' requires to be updated by calling '%2%'!") ) % obj_r->summary() % DEFAULTString("zypper dup");
 	}
       }
     }
+    return std::string();
   }
 } // namespace
 ///////////////////////////////////////////////////////////////////
+Summary::RowCells & Summary::rowCells( const ResPair & respair_r )
+{
+  auto it = _rowCells.find( respair_r );
+  if ( it != _rowCells.end() )
+    return it->second;
+
+  RowCells & cells( _rowCells[respair_r] );
+  // version (if multiple versions are present)
+  if ( _multiInstalled.find( respair_r.second->name() ) != _multiInstalled.end() )
+  {
+    if ( respair_r.first && respair_r.first->edition() != respair_r.second->edition() )
+      cells._mvsuffix = "-" + respair_r.first->edition().asString() + "->" + respair_r.second->edition().asString();
+    else
+      cells._mvsuffix = "-" + respair_r.second->edition().asString();
+  }
+  return cells;
+}
+
+const std::string & Summary::rowName( RowCells & cells_r, const ResPair & respair_r, bool withKind_r )
+{
+  std::optional<std::string> & name( withKind_r ? cells_r._ident : cells_r._name );
+  if ( ! name )
+    name = ResPair2Name( respair_r, withKind_r );
+  return *name;
+}
+
 bool Summary::writeResolvableList( std::ostream & out,
 				   const ResPairSet & resolvables,
 				   ansi::Color color,
@@ -444,12 +489,14 @@ bool Summary::writeResolvableList( std::ostream & out,
     unsigned relevant_entries = 0;
     for ( const ResPair & respair : resolvables )
     {
-      // name
-      const std::string & name( ResPair2Name( respair, withKind_r ) );
       ++relevant_entries;
       if ( maxEntires_r && relevant_entries > maxEntires_r )
 	continue;
 
+      // name
+      RowCells & cells( rowCells( respair ) );
+      const std::string & name( rowName( cells, respair, withKind_r ) );
+
       // quote names with spaces
       bool quote = name.find_first_of( " " ) != std::string::npos;
 
@@ -472,16 +519,7 @@ bool Summary::writeResolvableList( std::ostream & out,
       if ( quote ) s << quoteCh;
 
       // version (if multiple versions are present)
-      if ( _multiInstalled.find( respair.second->name() ) != _multiInstalled.end() )
-      {
-        if ( respair.first && respair.first->edition() != respair.second->edition() )
-	  s << "-" << respair.first->edition().asString()
-            << "->" << respair.second->edition().asString();
-        else
-	  s << "-" << respair.second->edition().asString();
-      }
-
-      s << " ";
+      s << cells._mvsuffix << " ";
     }
     if ( maxEntires_r && relevant_entries > maxEntires_r )
     {
@@ -503,58 +541,72 @@ bool Summary::writeResolvableList( std::ostream & out,
   t.margin(2);
   t.wrap(0);
 
+  // Cells not yet computed are filled on the fly; toggling a column at the
+  // prompt thus formats just that column (see RowCells).
   unsigned relevant_entries = 0;
   for ( const ResPair & respair : resolvables )
   {
     ++relevant_entries;
-    std::string name = ResPair2Name( respair, withKind_r );
     if ( maxEntires_r && relevant_entries > maxEntires_r )
       continue;
 
-    // version (if multiple versions are present)
-    if ( !(_viewop & SHOW_VERSION) && _multiInstalled.find( respair.second->name() ) != _multiInstalled.end() )
-    {
-      if ( respair.first && respair.first->edition() != respair.second->edition() )
-	name += std::string("-") + respair.first->edition().asString()
-             + "->" + respair.second->edition().asString();
-      else
-        name += std::string("-") + respair.second->edition().asString();
-    }
-
+    RowCells & cells( rowCells( respair ) );
     TableRow tr;
-    tr << name;
+    if ( !(_viewop & SHOW_VERSION) )
+      tr << rowName( cells, respair, withKind_r ) + cells._mvsuffix;
+    else
+      tr << rowName( cells, respair, withKind_r );
+
     if ( _viewop & SHOW_VERSION )
     {
-      if ( respair.first && respair.first->edition() != respair.second->edition() )
+      if ( ! cells._version )
       {
-        tr << respair.first->edition().asString() + " -> " +
-              respair.second->edition().asString();
-	// bsc#1061384: add hint if product is better updated by a different command
-	addUpdateHint( tr, _ctc, respair.second );
+	if ( respair.first && respair.first->edition() != respair.second->edition() )
+	{
+	  cells._version = respair.first->edition().asString() + " -> " +
+			   respair.second->edition().asString();
+	  // bsc#1061384: add hint if product is better updated by a different command
+	  cells._updateHint = updateHint( respair.second );
+	  if ( ! cells._updateHint.empty() )
+	    _ctc.push_back( cells._updateHint );
+	}
+	else
+	  cells._version = respair.second->edition().asString();
       }
-      else
-        tr << respair.second->edition().asString();
+      tr << *cells._version;
+      if ( ! cells._updateHint.empty() )
+	tr.addDetail( MSG_WARNINGString( cells._updateHint ) );
     }
     if ( _viewop & SHOW_ARCH )
     {
-      if ( respair.first && respair.first->arch() != respair.second->arch() )
-        tr << respair.first->arch().asString() + " -> " +
-              respair.second->arch().asString();
-      else
-        tr << respair.second->arch().asString();
+      if ( ! cells._arch )
+      {
+	if ( respair.first && respair.first->arch() != respair.second->arch() )
+	  cells._arch = respair.first->arch().asString() + " -> " +
+			respair.second->arch().asString();
+	else
+	  cells._arch = respair.second->arch().asString();
+      }
+      tr << *cells._arch;
     }
     if ( _viewop & SHOW_REPO )
     {
       // we do not know about repository changes, only show the repo from
       // which the package will be installed
-      tr << respair.second->repoInfo().asUserString();
+      if ( ! cells._repo )
+	cells._repo = respair.second->repoInfo().asUserString();
+      tr << *cells._repo;
     }
     if ( _viewop & SHOW_VENDOR )
     {
-      if ( respair.first && ! VendorAttr::instance().equivalent( respair.first->vendor(), respair.second->vendor() ) )
-        tr << respair.first->vendor() + " -> " + respair.second->vendor();
-      else
-        tr << respair.second->vendor();
+      if ( ! cells._vendor )
+      {
+	if ( respair.first && ! VendorAttr::instance().equivalent( respair.first->vendor(), respair.second->vendor() ) )
+	  cells._vendor = respair.first->vendor() + " -> " + respair.second->vendor();
+	else
+	  cells._vendor = respair.second->vendor();
+      }
+      tr << *cells._vendor;
     }
     t << std::move(tr);
   }
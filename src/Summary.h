@@ -11,6 +11,8 @@
 #include <set>
 #include <map>
 #include <iosfwd>
+#include <optional>
+#include <string>
 
 #include <zypp/base/PtrTypes.h>
 #include <zypp/ByteCount.h>
@@ -125,6 +127,24 @@ private:
 
   void collectInstalledRecommends( const ResObject::constPtr & obj );
 
+  /** The render-ready cells of a ResPair.
+   * Computed on first use and kept, so redrawing the summary after the
+   * prompt toggled a view option just formats the new column.
+   */
+  struct RowCells
+  {
+    std::string _mvsuffix;			///< version appended to the name if multiversion
+    std::optional<std::string> _name;
+    std::optional<std::string> _ident;		///< the name withKind
+    std::optional<std::string> _version;
+    std::optional<std::string> _arch;
+    std::optional<std::string> _repo;
+    std::optional<std::string> _vendor;
+    std::string _updateHint;			///< bsc#1061384: detail shown with the version
+  };
+  RowCells & rowCells( const ResPair & respair_r );
+  const std::string & rowName( RowCells & cells_r, const ResPair & respair_r, bool withKind_r );
+
   bool showNeedRestartHint() const;
   bool showNeedRebootHInt() const;
 
@@ -169,6 +189,8 @@ private:
 
   std::list<std::string> _ctc;		///< reasons to consider to cancel
 
+  std::map<ResPair, RowCells> _rowCells;	///< see \ref rowCells
+
 
   /** \name For weak deps info.
    * @{
@@ -1,6 +1,7 @@
 #include <iostream>
 #include <cstring>
 #include <cstdlib>
+#include <unordered_map>
 
 #include <zypp/base/LogTools.h>
 #include <zypp/base/String.h>
@@ -35,6 +36,24 @@ static const char * lines[][3] = {
   { ":", "-", "+" },					///< colon separated values
 };
 
+namespace
+{
+  inline TableRow::ColumnWidth columnWidth( boost::string_ref s )
+  {
+    if ( mbs_is_printable_ascii( s ) )
+      return { unsigned(s.size()), true };
+    return { unsigned(mbs_width( s )), false };
+  }
+
+  inline std::string::size_type commonPrefix( boost::string_ref lhs, boost::string_ref rhs )
+  {
+    std::string::size_type ret = 0;
+    while ( ret < lhs.size() && ret < rhs.size() && lhs[ret] == rhs[ret] )
+      ++ret;
+    return ret;
+  }
+} // namespace
+
 TableRow & TableRow::add( std::string s )
 {
   if ( _translateColumns )
@@ -49,6 +68,16 @@ TableRow & TableRow::addDetail( std::string s )
   return *this;
 }
 
+const std::vector<TableRow::ColumnWidth> & TableRow::updateColumnWidths() const
+{
+  const container & cols( columns() );
+  _columnWidths.clear();
+  _columnWidths.reserve( cols.size() );
+  for ( const std::string & col : cols )
+    _columnWidths.push_back( columnWidth( col ) );
+  return _columnWidths;
+}
+
 // 1st implementation: no width calculation, just tabs
 std::ostream & TableRow::dumbDumpTo( std::ostream & stream ) const
 {
@@ -64,51 +93,114 @@ std::ostream & TableRow::dumbDumpTo( std::ostream & stream ) const
   return stream << endl;
 }
 
-std::ostream & TableRow::dumpDetails( std::ostream & stream, const Table & parent ) const
+// ----------------------( Table )---------------------------------------------
+
+/** Column access for printing a \ref TableRow (i.e. the header). */
+struct Table::TableRowCells
 {
-  mbs::MbsWriteWrapped mww( stream, 4, parent._screen_width );
-  for ( const std::string & text : _details )
-  {
-    mww.writePar( text );
-  }
-  mww.gotoParBegin();
-  return stream;
-}
+  TableRowCells( const TableRow & row_r )
+  : _row( row_r )
+  , _useCache( ! row_r._translateColumns && row_r._columnWidths.size() == row_r._columns.size() )
+  {}
 
-std::ostream & TableRow::dumpTo( std::ostream & stream, const Table & parent ) const
+  unsigned size() const
+  { return _row._columns.size(); }
+
+  boost::string_ref text( unsigned c ) const
+  { return _row._columns[c]; }
+
+  /** Width as computed by \ref TableRow::updateColumnWidths (a header measures its translated columns) */
+  TableRow::ColumnWidth width( unsigned c ) const
+  { return _row._columnWidths[c]; }
+
+  /** Width of the \ref text actually printed */
+  TableRow::ColumnWidth printWidth( unsigned c ) const
+  { return _useCache ? _row._columnWidths[c] : columnWidth( _row._columns[c] ); }
+
+  ColorContext ctxt() const
+  { return _row._ctxt; }
+
+  unsigned details() const
+  { return _row._details.size(); }
+
+  boost::string_ref detail( unsigned n ) const
+  { return _row._details[n]; }
+
+  const TableRow & _row;
+  bool _useCache;
+};
+
+/** Column access for printing a stored row. */
+struct Table::StoredCells
+{
+  StoredCells( const Table & table_r, uint32_t idx_r )
+  : _table( table_r )
+  , _row( table_r._rowData[idx_r] )
+  {}
+
+  unsigned size() const
+  { return _row._ncells; }
+
+  const Cell & cell( unsigned c ) const
+  { return _table._cells[_row._cells+c]; }
+
+  boost::string_ref text( unsigned c ) const
+  { return cell( c ).text(); }
+
+  TableRow::ColumnWidth width( unsigned c ) const
+  { return { cell( c )._width, bool(cell( c )._ascii) }; }
+
+  TableRow::ColumnWidth printWidth( unsigned c ) const
+  { return width( c ); }
+
+  ColorContext ctxt() const
+  { return _row._ctxt; }
+
+  unsigned details() const
+  { return _row._ndetails; }
+
+  boost::string_ref detail( unsigned n ) const
+  { return _table._detailCells[_row._details+n].text(); }
+
+  const Table & _table;
+  const RowData & _row;
+};
+
+template <class TCells>
+std::ostream & Table::dumpRow( std::ostream & stream, const TCells & cells_r ) const
 {
-  const char * vline = parent._style == none ? "" : lines[parent._style][0];
+  const char * vline = _style == none ? "" : lines[_style][0];
+  const ColorContext ctxt( cells_r.ctxt() );
 
   unsigned ssize = 0; // string size in columns
   bool seen_first = false;
 
   stream.setf( std::ios::left, std::ios::adjustfield );
-  stream << std::string( parent._margin, ' ' );
+  stream << std::string( _margin, ' ' );
   // current position at currently printed line
-  int curpos = parent._margin;
+  int curpos = _margin;
   // On a table with 2 edition columns highlight the editions
   // except for the common prefix.
   std::string::size_type editionSep( std::string::npos );
 
-  container::const_iterator i = _columns.begin (), e = _columns.end ();
-  const unsigned lastCol = _columns.size() - 1;
-  for ( unsigned c = 0; i != e ; ++i, ++c )
+  const unsigned lastCol = cells_r.size() - 1;
+  for ( unsigned c = 0; c < cells_r.size(); ++c )
   {
-    const std::string & s( *i );
+    boost::string_ref s( cells_r.text( c ) );
 
     if ( seen_first )
     {
-      bool do_wrap = parent._do_wrap				// user requested wrapping
-		  && parent._width > parent._screen_width	// table is wider than screen
-		  && ( curpos + (int)parent._max_width[c] + (parent._style == none ? 2 : 3) > parent._screen_width	// the next table column would exceed the screen size
-		    || parent._force_break_after == (int)(c - 1) );	// or the user wishes to first break after the previous column
+      bool do_wrap = _do_wrap				// user requested wrapping
+		  && _width > _screen_width		// table is wider than screen
+		  && ( curpos + (int)_max_width[c] + (_style == none ? 2 : 3) > _screen_width	// the next table column would exceed the screen size
+		    || _force_break_after == (int)(c - 1) );	// or the user wishes to first break after the previous column
 
       if ( do_wrap )
       {
         // start printing the next table columns to new line,
         // indent by 2 console columns
-        stream << endl << std::string( parent._margin + 2, ' ' );
-        curpos = parent._margin + 2; // indent == 2
+        stream << endl << std::string( _margin + 2, ' ' );
+        curpos = _margin + 2; // indent == 2
       }
       else
         // vertical line, padded with spaces
@@ -119,25 +211,32 @@ std::ostream & TableRow::dumpTo( std::ostream & stream, const Table & parent ) c
       seen_first = true;
 
     // stream.width (widths[c]); // that does not work with multibyte chars
-    ssize = mbs_width( s );
-    if ( ssize > parent._max_width[c] )
+    const TableRow::ColumnWidth cw( cells_r.printWidth( c ) );
+    ssize = cw._width;
+    if ( ssize > _max_width[c] )
     {
-      unsigned cutby = parent._max_width[c] - 2;
-      std::string cutstr = mbs_substr_by_width( s, 0, cutby );
-      stream << ( _ctxt << cutstr ) << std::string(cutby - mbs_width( cutstr ), ' ') << "->";
+      unsigned cutby = _max_width[c] - 2;
+      if ( cw._ascii )
+	stream << ( ctxt << s.substr( 0, cutby ) ) << "->";
+      else
+      {
+	std::string cutstr = mbs_substr_by_width( s, 0, cutby );
+	stream << ( ctxt << cutstr ) << std::string(cutby - mbs_width( cutstr ), ' ') << "->";
+      }
     }
     else
     {
-      if ( !parent._inHeader && parent.editionStyle( c ) && Zypper::instance().config().do_colors )
+      if ( !_inHeader && editionStyle( c ) && Zypper::instance().config().do_colors )
       {
 	// Edition column
-	if ( parent._editionStyle.size() == 2 )
+	if ( _editionStyle.size() == 2 )
 	{
 	  // 2 Edition columns - highlight difference
 	  if ( editionSep == std::string::npos )
 	  {
-	    editionSep = str::commonPrefix( _columns[*parent._editionStyle.begin()],
-						  _columns[*(++parent._editionStyle.begin())] );
+	    unsigned lcol = *_editionStyle.begin();
+	    unsigned rcol = *(++_editionStyle.begin());
+	    editionSep = ( rcol < cells_r.size() ? commonPrefix( cells_r.text( lcol ), cells_r.text( rcol ) ) : 0 );
 	  }
 
 	  if ( editionSep == 0 )
@@ -146,11 +245,11 @@ std::ostream & TableRow::dumpTo( std::ostream & stream, const Table & parent ) c
 	  }
 	  else if ( editionSep == s.size() )
 	  {
-	    stream << ( _ctxt << s );
+	    stream << ( ctxt << s );
 	  }
 	  else
 	  {
-	    stream << ( _ctxt << s.substr( 0, editionSep ) ) << ( ColorContext::CHANGE << s.substr( editionSep ) );
+	    stream << ( ctxt << s.substr( 0, editionSep ) ) << ( ColorContext::CHANGE << s.substr( editionSep ) );
 	  }
 	}
 	else
@@ -159,36 +258,121 @@ std::ostream & TableRow::dumpTo( std::ostream & stream, const Table & parent ) c
 	  editionSep = s.find( '-' );
 	  if ( editionSep != std::string::npos )
 	  {
-	    stream << ( _ctxt << s.substr( 0, editionSep ) << ( ColorContext::HIGHLIGHT << "-" ) << s.substr( editionSep+1 ) );
+	    stream << ( ctxt << s.substr( 0, editionSep ) << ( ColorContext::HIGHLIGHT << "-" ) << s.substr( editionSep+1 ) );
 	  }
 	  else	// no release part
 	  {
-	    stream << ( _ctxt << s );
+	    stream << ( ctxt << s );
 	  }
 	}
       }
       else	// no special style
       {
-	stream << ( _ctxt << s );
+	stream << ( ctxt << s );
       }
-      stream.width( c == lastCol ? 0 : parent._max_width[c] - ssize );
+      stream.width( c == lastCol ? 0 : _max_width[c] - ssize );
     }
     stream << "";
-    curpos += parent._max_width[c] + (parent._style == none ? 2 : 3);
+    curpos += _max_width[c] + (_style == none ? 2 : 3);
   }
   stream << endl;
 
-  if ( !_details.empty() )
+  if ( cells_r.details() )
   {
-    dumpDetails( stream, parent );
+    mbs::MbsWriteWrapped mww( stream, 4, _screen_width );
+    for ( unsigned n = 0; n < cells_r.details(); ++n )
+      mww.writePar( cells_r.detail( n ) );
+    mww.gotoParBegin();
   }
   return stream;
 }
 
-// ----------------------( Table )---------------------------------------------
+std::ostream & TableRow::dumpTo( std::ostream & stream, const Table & parent ) const
+{ return parent.dumpRow( stream, Table::TableRowCells( *this ) ); }
+
+unsigned Table::RowRef::size() const
+{ return _table->_rowData[_idx]._ncells; }
+
+boost::string_ref Table::RowRef::operator[]( unsigned col_r ) const
+{
+  const RowData & row( _table->_rowData[_idx] );
+  return col_r < row._ncells ? _table->_cells[row._cells+col_r].text() : boost::string_ref();
+}
+
+unsigned Table::RowRef::details() const
+{ return _table->_rowData[_idx]._ndetails; }
+
+boost::string_ref Table::RowRef::detail( unsigned n_r ) const
+{
+  const RowData & row( _table->_rowData[_idx] );
+  return n_r < row._ndetails ? _table->_detailCells[row._details+n_r].text() : boost::string_ref();
+}
+
+const boost::any & Table::RowRef::userData() const
+{ return _table->_userData[_idx]; }
+
+TableRow Table::RowRef::tableRow() const
+{ return _table->storedRow( _idx ); }
+
+const char * Table::Arena::add( boost::string_ref text_r )
+{
+  static constexpr size_t chunkSize = 64 * 1024;
+
+  if ( text_r.empty() )
+    return "";
+
+  if ( text_r.size() > _avail )
+  {
+    if ( text_r.size() > chunkSize / 4 )
+    {
+      // big ones get a chunk of their own
+      _chunks.emplace_back( new char[text_r.size()] );
+      ::memcpy( _chunks.back().get(), text_r.data(), text_r.size() );
+      return _chunks.back().get();
+    }
+    _chunks.emplace_back( new char[chunkSize] );
+    _next = _chunks.back().get();
+    _avail = chunkSize;
+  }
+
+  char * ret = _next;
+  ::memcpy( ret, text_r.data(), text_r.size() );
+  _next += text_r.size();
+  _avail -= text_r.size();
+  return ret;
+}
+
+const Table::Cell & Table::Arena::intern( boost::string_ref text_r, bool & added_r )
+{
+  auto it = _interned.find( text_r );
+  added_r = ( it == _interned.end() );
+  if ( added_r )
+  {
+    Cell cell;
+    cell._text = add( text_r );
+    cell._size = text_r.size();
+    TableRow::ColumnWidth cw = columnWidth( text_r );
+    cell._width = cw._width;
+    cell._ascii = cw._ascii;
+    cell._interned = true;
+    // key refers to the stored copy
+    it = _interned.emplace( boost::string_ref( cell._text, cell._size ), cell ).first;
+  }
+  return it->second;
+}
+
+size_t Table::Arena::Hash::operator()( boost::string_ref str_r ) const
+{
+  size_t ret = 14695981039346656037ULL;	// FNV-1a
+  for ( unsigned char ch : str_r )
+  { ret ^= ch; ret *= 1099511628211ULL; }
+  return ret;
+}
 
 Table::Table()
   : _has_header( false )
+  , _hasPending( false )
+  , _pendingPos( std::string::npos )
   , _max_col( 0 )
   , _max_width( 1, 0 )
   , _width( 0 )
@@ -202,10 +386,285 @@ Table::Table()
 
 Table & Table::add( TableRow tr )
 {
-  _rows.push_back( std::move(tr) );
+  store();
+  _pending = std::move(tr);
+  _hasPending = true;
   return *this;
 }
 
+Table::Cell Table::storeColumnCell( const std::string & text_r, unsigned col_r ) const
+{
+  if ( text_r.size() > Arena::internMax )
+    return storeCell( text_r, true );
+
+  if ( col_r >= _internStats.size() )
+    _internStats.resize( col_r + 1 );
+  InternStats & stats( _internStats[col_r] );
+  if ( stats._added > 64 && stats._added > stats._seen / 2 )
+    return storeCell( text_r, true );	// mostly distinct values: not worth it
+
+  bool added;
+  const Cell & ret( _arena->intern( text_r, added ) );
+  ++stats._seen;
+  if ( added )
+    ++stats._added;
+  return ret;
+}
+
+Table::Cell Table::storeCell( const std::string & text_r, bool measure_r ) const
+{
+  Cell ret;
+  ret._text = _arena->add( text_r );
+  ret._size = text_r.size();
+  TableRow::ColumnWidth cw { 0, false };
+  if ( measure_r )
+    cw = columnWidth( text_r );
+  ret._width = cw._width;
+  ret._ascii = cw._ascii;
+  ret._interned = false;
+  return ret;
+}
+
+void Table::store() const
+{
+  if ( ! _hasPending )
+    return;
+  if ( ! _arena )
+    _arena = std::make_shared<Arena>();
+
+  const uint32_t idx = _rowData.size();
+  _rowData.push_back( RowData { uint32_t(_cells.size()), uint32_t(_detailCells.size()),
+                                uint32_t(_pending._columns.size()), uint32_t(_pending._details.size()),
+                                _pending._ctxt } );
+  for ( unsigned col = 0; col < _pending._columns.size(); ++col )
+    _cells.push_back( storeColumnCell( _pending._columns[col], col ) );
+  for ( const std::string & detail : _pending._details )
+    _detailCells.push_back( storeCell( detail, false ) );
+  _userData.push_back( std::move(_pending._userData) );
+
+  if ( _pendingPos < _order.size() )
+    _order.insert( _order.begin() + _pendingPos, idx );
+  else
+    _order.push_back( idx );
+
+  _pending = TableRow();
+  _hasPending = false;
+  _pendingPos = std::string::npos;
+}
+
+TableRow Table::storedRow( uint32_t idx_r ) const
+{
+  const RowData & row( _rowData[idx_r] );
+  TableRow tr( row._ncells, row._ctxt );
+  for ( uint32_t c = 0; c < row._ncells; ++c )
+    tr.add( _cells[row._cells+c].text().to_string() );
+  for ( uint32_t n = 0; n < row._ndetails; ++n )
+    tr.addDetail( _detailCells[row._details+n].text().to_string() );
+  tr.userData( _userData[idx_r] );
+  return tr;
+}
+
+void Table::reopen( size_t pos_r )
+{
+  const uint32_t idx = _order[pos_r];
+  _pending = storedRow( idx );
+  _hasPending = true;
+  _pendingPos = pos_r;	// keep its place in a sorted table
+  _order.erase( _order.begin() + pos_r );
+
+  RowData & row( _rowData[idx] );
+  if ( idx + 1 == _rowData.size() )
+  {
+    // the row added last: release its storage
+    _cells.resize( row._cells );
+    _detailCells.resize( row._details );
+    _userData.pop_back();
+    _rowData.pop_back();
+  }
+  else
+  {
+    // leave an unused (empty) row behind; it is no longer in _order
+    row._ncells = row._ndetails = 0;
+    _userData[idx] = boost::any();
+  }
+}
+
+TableRow & Table::lastRow()
+{
+  if ( ! _hasPending )
+  {
+    if ( _rowData.empty() )
+      ZYPP_THROW( zypp::Exception( "Table has no rows" ) );
+
+    // take the row added last out of the storage again
+    const uint32_t idx = _rowData.size() - 1;
+    reopen( std::find( _order.begin(), _order.end(), idx ) - _order.begin() );
+  }
+  return _pending;
+}
+
+TableRow & Table::row( size_t pos_r )
+{
+  if ( _hasPending && pos_r == std::min( _pendingPos, _order.size() ) )
+    return _pending;
+
+  store();
+  if ( pos_r >= _order.size() )
+    ZYPP_THROW( zypp::Exception( "Table row index out of range" ) );
+  reopen( pos_r );
+  return _pending;
+}
+
+namespace
+{
+  /** Rank the \c Tp user data of \a rows_r into \a ranks_r (1-based, equal values share a rank). */
+  template <class Tp>
+  void rankTypedUserData( const std::vector<boost::any> & userData_r, const std::vector<uint32_t> & rows_r, std::vector<uint32_t> & ranks_r )
+  {
+    std::vector<std::pair<const Tp *, uint32_t>> vals;
+    vals.reserve( rows_r.size() );
+    for ( uint32_t row : rows_r )
+    {
+      if ( const Tp * val = boost::any_cast<Tp>( &userData_r[row] ) )
+	vals.push_back( { val, row } );
+    }
+    std::sort( vals.begin(), vals.end(), []( const std::pair<const Tp *, uint32_t> & lhs, const std::pair<const Tp *, uint32_t> & rhs ) {
+      return csidetail::simpleTypeComp<Tp>( *lhs.first, *rhs.first ) < 0;
+    } );
+    uint32_t rank = 0;
+    for ( size_t i = 0; i < vals.size(); ++i )
+    {
+      if ( i == 0 || csidetail::simpleTypeComp<Tp>( *vals[i-1].first, *vals[i].first ) != 0 )
+	++rank;
+      ranks_r[vals[i].second] = rank;
+    }
+  }
+} // namespace
+
+void Table::rankColumn( unsigned col_r, std::vector<uint32_t> & ranks_r ) const
+{
+  // distinct values first, so repeated ones are sorted only once
+  // (interned cells are looked up by their address first)
+  std::unordered_map<boost::string_ref, uint32_t, Arena::Hash> distinct;
+  std::unordered_map<const char *, uint32_t> interned;
+  std::vector<boost::string_ref> values;
+  auto valueIdx = [&]( boost::string_ref text_r ) {
+    auto res = distinct.emplace( text_r, values.size() );
+    if ( res.second )
+      values.push_back( text_r );
+    return res.first->second;
+  };
+  for ( uint32_t row = 0; row < _rowData.size(); ++row )
+  {
+    if ( col_r >= _rowData[row]._ncells )
+      continue;
+    const Cell & cell( _cells[_rowData[row]._cells+col_r] );
+    if ( cell._interned )
+    {
+      auto it = interned.find( cell._text );
+      if ( it == interned.end() )
+	it = interned.emplace( cell._text, valueIdx( cell.text() ) ).first;
+      ranks_r[row] = it->second;
+    }
+    else
+      ranks_r[row] = valueIdx( cell.text() );
+  }
+
+  std::vector<uint32_t> byValue( values.size() );
+  for ( uint32_t i = 0; i < byValue.size(); ++i )
+    byValue[i] = i;
+  std::sort( byValue.begin(), byValue.end(), [&values]( uint32_t lhs, uint32_t rhs ) {
+    return values[lhs] < values[rhs];
+  } );
+  std::vector<uint32_t> rankOf( values.size() );
+  for ( uint32_t i = 0; i < byValue.size(); ++i )
+    rankOf[byValue[i]] = i;
+
+  for ( uint32_t row = 0; row < _rowData.size(); ++row )
+  {
+    if ( col_r < _rowData[row]._ncells )
+      ranks_r[row] = rankOf[ranks_r[row]];
+  }
+}
+
+void Table::rankUserData( const std::vector<uint32_t> & rows_r, std::vector<uint32_t> & ranks_r ) const
+{
+  // empty user data ranks 0 (first); all others must be of the same type
+  const std::type_info * type = nullptr;
+  for ( uint32_t row : rows_r )
+  {
+    ranks_r[row] = 0;
+    const boost::any & userData( _userData[row] );
+    if ( userData.empty() )
+      continue;
+    if ( ! type )
+      type = &userData.type();
+    else if ( *type != userData.type() )
+      ZYPP_THROW( zypp::Exception( str::form("Incompatible user types") ) );
+  }
+
+  if ( ! type )
+    return;
+  else if ( *type == typeid(SolvableCSI) )
+    rankTypedUserData<SolvableCSI>( _userData, rows_r, ranks_r );
+  else if ( *type == typeid(std::string) )
+    rankTypedUserData<std::string>( _userData, rows_r, ranks_r );
+  else if ( *type == typeid(unsigned) )
+    rankTypedUserData<unsigned>( _userData, rows_r, ranks_r );
+  else if ( *type == typeid(int) )
+    rankTypedUserData<int>( _userData, rows_r, ranks_r );
+  else
+    ZYPP_THROW( zypp::Exception( str::form("Unsupported user types") ) );
+}
+
+void Table::sortBy( const std::list<unsigned> & byColumns_r )
+{
+  store();
+  const size_t nrows = _rowData.size();
+  if ( nrows < 2 )
+    return;
+
+  // Compute a sort key per row and sort column once, so sorting compares
+  // integers only (same order as TableRow::Less, see Table_test):
+  //  - rows having the column rank by its text (high word 1),
+  //  - rows lacking it sort first, among themselves ordered by user data.
+  const size_t nkeys = byColumns_r.size();
+  std::vector<uint64_t> keys( nrows * nkeys );
+  std::vector<uint32_t> ranks( nrows );
+  std::vector<uint32_t> missing;
+  size_t k = 0;
+  for ( unsigned col : byColumns_r )
+  {
+    missing.clear();
+    for ( uint32_t row = 0; row < nrows; ++row )
+    {
+      if ( col >= _rowData[row]._ncells )
+	missing.push_back( row );
+    }
+    if ( missing.size() < nrows )
+      rankColumn( col, ranks );
+    if ( missing.size() > 1 )
+      rankUserData( missing, ranks );
+    else if ( missing.size() == 1 )
+      ranks[missing[0]] = 0;
+
+    for ( uint32_t row = 0; row < nrows; ++row )
+      keys[row*nkeys+k] = ( uint64_t( col < _rowData[row]._ncells ) << 32 ) | ranks[row];
+    ++k;
+  }
+
+  std::stable_sort( _order.begin(), _order.end(), [&keys,nkeys]( uint32_t lhs, uint32_t rhs ) {
+    const uint64_t * lkey = &keys[lhs*nkeys];
+    const uint64_t * rkey = &keys[rhs*nkeys];
+    for ( size_t i = 0; i < nkeys; ++i )
+    {
+      if ( lkey[i] != rkey[i] )
+	return lkey[i] < rkey[i];
+    }
+    return false;
+  } );
+}
+
 Table & Table::setHeader( TableHeader tr )
 {
   _header = std::move(tr);
@@ -223,7 +682,8 @@ void Table::allowAbbrev( unsigned column)
   _abbrev_col[column] = true;
 }
 
-void Table::updateColWidths( const TableRow & tr ) const
+template <class TCells>
+void Table::updateColWidths( const TCells & cells_r ) const
 {
   // how much columns spearators add to the width of the table
   int sepwidth = _style == none ? 2 : 3;
@@ -232,18 +692,16 @@ void Table::updateColWidths( const TableRow & tr ) const
   _width = -sepwidth;
 
   // ensure that _max_width[col] exists
-  const auto &columns = tr.columns();
-  if ( _max_width.size() < columns.size() )
+  if ( _max_width.size() < cells_r.size() )
   {
-    _max_width.resize( columns.size(), 0 );
+    _max_width.resize( cells_r.size(), 0 );
     _max_col = _max_width.size()-1;
   }
 
-  unsigned c = 0;
-  for ( const auto & col : columns )
+  for ( unsigned c = 0; c < cells_r.size(); ++c )
   {
-    unsigned &max = _max_width[c++];
-    unsigned cur = mbs_width( col );
+    unsigned &max = _max_width[c];
+    unsigned cur = cells_r.width( c )._width;
 
     if ( max < cur )
       max = cur;
@@ -274,14 +732,17 @@ void Table::dumpRule( std::ostream &stream ) const
   stream << endl;
 }
 
-std::ostream & Table::dumpTo( std::ostream & stream ) const
+void Table::updateHeaderWidths() const
 {
-  // compute column sizes
   if ( _has_header )
-    updateColWidths( _header );
-  for ( const auto & row : _rows )
-    updateColWidths( row );
+  {
+    _header.updateColumnWidths();
+    updateColWidths( TableRowCells( _header ) );
+  }
+}
 
+void Table::dumpHeader( std::ostream & stream ) const
+{
   // reset column widths for columns that can be abbreviated
   //! \todo allow abbrev of multiple columns?
   unsigned c = 0;
@@ -302,12 +763,23 @@ std::ostream & Table::dumpTo( std::ostream & stream ) const
   {
     DtorReset inHeader( _inHeader, false );
     _inHeader = true;
-    _header.dumpTo( stream, *this );
+    dumpRow( stream, TableRowCells( _header ) );
     dumpRule (stream);
   }
+}
 
-  for ( const auto & row : _rows )
-    row.dumpTo( stream, *this );
+std::ostream & Table::dumpTo( std::ostream & stream ) const
+{
+  store();
+
+  // compute column sizes
+  updateHeaderWidths();
+  for ( uint32_t idx : _order )
+    updateColWidths( StoredCells( *this, idx ) );
+
+  dumpHeader( stream );
+  for ( uint32_t idx : _order )
+    dumpRow( stream, StoredCells( *this, idx ) );
 
   return stream;
 }
@@ -333,6 +805,70 @@ void Table::margin( unsigned margin )
     ERR << "margin of " << margin << " is greater than half of the screen" << endl;
 }
 
+// ----------------------( StreamingTable )------------------------------------
+
+namespace
+{
+  /** Column access to the widths of cells measured one by one. */
+  struct CellWidths
+  {
+    CellWidths( const std::vector<TableRow::ColumnWidth> & widths_r )
+    : _widths( widths_r )
+    {}
+
+    unsigned size() const
+    { return _widths.size(); }
+
+    TableRow::ColumnWidth width( unsigned c ) const
+    { return _widths[c]; }
+
+    const std::vector<TableRow::ColumnWidth> & _widths;
+  };
+} // namespace
+
+StreamingTable::StreamingTable( std::ostream & stream_r )
+: _stream( stream_r )
+, _measuring( false )
+, _printing( false )
+{}
+
+void StreamingTable::measure( const TableRow & row_r )
+{
+  if ( ! _measuring )
+  {
+    _measuring = true;
+    _table.updateHeaderWidths();
+  }
+  row_r.updateColumnWidths();
+  _table.updateColWidths( Table::TableRowCells( row_r ) );
+}
+
+void StreamingTable::measure( unsigned col_r, boost::string_ref text_r )
+{
+  // applied when printing starts (the header may not be set yet)
+  if ( col_r >= _cellWidths.size() )
+    _cellWidths.resize( col_r + 1, TableRow::ColumnWidth { 0, true } );
+  unsigned width = columnWidth( text_r )._width;
+  if ( width > _cellWidths[col_r]._width )
+    _cellWidths[col_r]._width = width;
+}
+
+void StreamingTable::print( const TableRow & row_r )
+{
+  if ( ! _printing )
+  {
+    _printing = true;
+    if ( ! _measuring )
+      _table.updateHeaderWidths();
+    if ( ! _cellWidths.empty() )
+      _table.updateColWidths( CellWidths( _cellWidths ) );
+    _table.dumpHeader( _stream );
+  }
+  if ( row_r.size() > _table._max_width.size() )
+    measure( row_r );	// unmeasured row with extra columns
+  _table.dumpRow( _stream, Table::TableRowCells( row_r ) );
+}
+
 // Local Variables:
 // c-basic-offset: 2
 // End:
@@ -17,8 +17,13 @@
 #include <set>
 #include <list>
 #include <vector>
+#include <unordered_map>
+#include <memory>
+#include <algorithm>
+#include <cstdint>
 
 #include <boost/any.hpp>
+#include <boost/utility/string_ref.hpp>
 
 #include <zypp/base/String.h>
 #include <zypp/base/Exception.h>
@@ -36,21 +41,14 @@ typedef std::pair<zypp::sat::Solvable, ui::Selectable::picklist_size_type> Solva
 // Custom sort index helpers
 namespace csidetail
 {
-  /** Default comparator for custom sort indices (std::compare semantic). */
+  /** Default comparator for custom sort index values (std::compare semantic). */
   template <typename T>
-  inline int simpleAnyTypeComp ( const boost::any &l_r, const boost::any &r_r )
-  {
-    T l = boost::any_cast<T>(l_r);
-    T r = boost::any_cast<T>(r_r);
-    return ( l < r ? -1 : l > r ?  1 : 0 );
-  }
+  inline int simpleTypeComp ( const T &l, const T &r )
+  { return ( l < r ? -1 : l > r ?  1 : 0 ); }
 
   template <>
-  inline int simpleAnyTypeComp<SolvableCSI> ( const boost::any &l_r, const boost::any &r_r )
+  inline int simpleTypeComp<SolvableCSI> ( const SolvableCSI &l, const SolvableCSI &r )
   {
-    SolvableCSI l = boost::any_cast<SolvableCSI>(l_r);
-    SolvableCSI r = boost::any_cast<SolvableCSI>(r_r);
-
     if ( l.first == r.first )
       return 0;	// quick check Solvable Id
 
@@ -66,6 +64,11 @@ namespace csidetail
       return 0;
     return ( l.second < r.second ? -1 : 1 );	// `>`! best version up
   }
+
+  /** Default comparator for custom sort indices (std::compare semantic). */
+  template <typename T>
+  inline int simpleAnyTypeComp ( const boost::any &l_r, const boost::any &r_r )
+  { return simpleTypeComp<T>( boost::any_cast<const T &>(l_r), boost::any_cast<const T &>(r_r) ); }
 } // namespace csidetail
 ///////////////////////////////////////////////////////////////////
 
@@ -141,9 +144,6 @@ auto ColumnIf( bool condition_r, Tif_ && if_r ) -> ctcdetail::ColumnIf<decltype(
 
 class TableRow
 {
-private:
-  std::ostream & dumpDetails( std::ostream & stream, const Table & parent ) const;
-
 public:
   TableRow()
   : _ctxt( ColorContext::DEFAULT )
@@ -192,13 +192,28 @@ public:
 
   typedef std::vector<std::string> container;
 
+  /** Screen width of a column and whether it is plain printable ASCII. */
+  struct ColumnWidth
+  {
+    unsigned _width;
+    bool     _ascii;
+  };
+
+  /** Compute and remember the \ref ColumnWidth of all \ref columns.
+   * \ref dumpTo reuses them instead of measuring each cell again.
+   */
+  const std::vector<ColumnWidth> & updateColumnWidths() const;
+
   const boost::any &userData() const
   { return _userData; }
 
   void userData( const boost::any &n_r )
   { _userData = n_r; }
 
-  // BinaryPredicate
+  /** BinaryPredicate ordering rows by columns like \ref Table::sort does.
+   * The Table sorts by precomputed keys instead; this is the reference
+   * order they must reproduce (e.g. for \ref Table::sort with a TableRow comparator).
+   */
   struct Less
   {
     std::list<unsigned> _by_columns;
@@ -223,42 +238,44 @@ public:
       bool noR = curr_column_r >= b_r._columns.size();
 
       if ( noL || noR ) {
-        if ( noL && noR ) {
-	  using csidetail::simpleAnyTypeComp;
+        if ( noL && noR )
+          return compUserData( a_r.userData(), b_r.userData() );
+        else
+          return ( noL && ! noR ? -1 : ! noL && noR ?  1 : 0);
+      }
+      return ( a_r._columns[curr_column_r] < b_r._columns[curr_column_r] ? -1 : a_r._columns[curr_column_r] > b_r._columns[curr_column_r] ?  1 : 0 );
+    }
 
-          const boost::any &lUserData = a_r.userData();
-          const boost::any &rUserData = b_r.userData();
+    static int compUserData( const boost::any & lUserData, const boost::any & rUserData )
+    {
+      using csidetail::simpleAnyTypeComp;
 
-          if ( lUserData.empty() && !rUserData.empty() )
-            return -1;
+      if ( lUserData.empty() && !rUserData.empty() )
+        return -1;
 
-          else if ( !lUserData.empty() && rUserData.empty() )
-            return 1;
+      else if ( !lUserData.empty() && rUserData.empty() )
+        return 1;
 
-          else if ( lUserData.empty() && rUserData.empty() )
-            return 0;
+      else if ( lUserData.empty() && rUserData.empty() )
+        return 0;
 
-          else if ( lUserData.type() != rUserData.type() ) {
-            ZYPP_THROW( zypp::Exception( str::form("Incompatible user types") ) );
+      else if ( lUserData.type() != rUserData.type() ) {
+        ZYPP_THROW( zypp::Exception( str::form("Incompatible user types") ) );
 
-          } else if ( lUserData.type() == typeid(SolvableCSI) ) {
-            return simpleAnyTypeComp<SolvableCSI> ( lUserData, rUserData );
+      } else if ( lUserData.type() == typeid(SolvableCSI) ) {
+        return simpleAnyTypeComp<SolvableCSI> ( lUserData, rUserData );
 
-          } else if ( lUserData.type() == typeid(std::string) ) {
-            return simpleAnyTypeComp<std::string>( lUserData, rUserData );
+      } else if ( lUserData.type() == typeid(std::string) ) {
+        return simpleAnyTypeComp<std::string>( lUserData, rUserData );
 
-          } else if ( lUserData.type() == typeid(unsigned) ) {
-            return simpleAnyTypeComp<unsigned>( lUserData, rUserData );
+      } else if ( lUserData.type() == typeid(unsigned) ) {
+        return simpleAnyTypeComp<unsigned>( lUserData, rUserData );
 
-          } else if ( lUserData.type() == typeid(int) ) {
-            return simpleAnyTypeComp<int>( lUserData, rUserData );
+      } else if ( lUserData.type() == typeid(int) ) {
+        return simpleAnyTypeComp<int>( lUserData, rUserData );
 
-          }
-          ZYPP_THROW( zypp::Exception( str::form("Unsupported user types") ) );
-        } else
-          return ( noL && ! noR ? -1 : ! noL && noR ?  1 : 0);
       }
-      return ( a_r._columns[curr_column_r] < b_r._columns[curr_column_r] ? -1 : a_r._columns[curr_column_r] > b_r._columns[curr_column_r] ?  1 : 0 );
+      ZYPP_THROW( zypp::Exception( str::form("Unsupported user types") ) );
     }
   };
 
@@ -282,6 +299,9 @@ private:
   container _details;
   ColorContext _ctxt;
   boost::any _userData;	///< user defined sort index, e.g. if string values don't work due to coloring
+  mutable std::vector<ColumnWidth> _columnWidths;	///< cache filled by updateColumnWidths
+
+  friend class Table;
 };
 
 /** \relates TableRow Add colummn. */
@@ -334,8 +354,84 @@ TableHeader && operator<<( TableHeader && th, Tp_ && val )
 class Table
 {
 public:
-  typedef std::list<TableRow> container;
+  ///////////////////////////////////////////////////////////////////
+  /// \class Table::RowRef
+  /// \brief Read only view of a row stored in a \ref Table.
+  ///
+  /// Rows are stored in columnar form once they were added, so
+  /// they are no \ref TableRow objects anymore. A RowRef is valid
+  /// until the next row is added to the table.
+  ///////////////////////////////////////////////////////////////////
+  class RowRef
+  {
+  public:
+    /** Number of columns. */
+    unsigned size() const;
+    unsigned cols() const			{ return size(); }
+    bool empty() const				{ return ! size(); }
+
+    /** The text in column \a col_r. */
+    boost::string_ref operator[]( unsigned col_r ) const;
 
+    /** Number of detail lines. */
+    unsigned details() const;
+    /** The \a n_r th detail line. */
+    boost::string_ref detail( unsigned n_r ) const;
+
+    const boost::any & userData() const;
+
+    /** A copy of the row as \ref TableRow. */
+    TableRow tableRow() const;
+
+  private:
+    friend class Table;
+    RowRef( const Table & table_r, uint32_t idx_r )
+    : _table( &table_r ), _idx( idx_r )
+    {}
+    const Table * _table;
+    uint32_t _idx;	///< index into the Tables row storage
+  };
+
+  ///////////////////////////////////////////////////////////////////
+  /// \class Table::Rows
+  /// \brief The stored rows in display (i.e. sorted) order.
+  ///////////////////////////////////////////////////////////////////
+  class Rows
+  {
+  public:
+    struct const_iterator
+    {
+      typedef std::forward_iterator_tag iterator_category;
+      typedef RowRef value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef void pointer;
+      typedef RowRef reference;
+
+      RowRef operator*() const			{ return RowRef( *_table, _table->_order[_pos] ); }
+      const_iterator & operator++()		{ ++_pos; return *this; }
+      const_iterator operator++( int )		{ const_iterator ret( *this ); ++_pos; return ret; }
+      bool operator==( const const_iterator & rhs ) const { return _pos == rhs._pos; }
+      bool operator!=( const const_iterator & rhs ) const { return _pos != rhs._pos; }
+
+      const Table * _table;
+      size_t _pos;
+    };
+
+    bool empty() const				{ return _table->_order.empty(); }
+    size_t size() const				{ return _table->_order.size(); }
+    RowRef operator[]( size_t n_r ) const	{ return RowRef( *_table, _table->_order[n_r] ); }
+    const_iterator begin() const		{ return const_iterator { _table, 0 }; }
+    const_iterator end() const			{ return const_iterator { _table, size() }; }
+
+  private:
+    friend class Table;
+    Rows( const Table & table_r )
+    : _table( &table_r )
+    {}
+    const Table * _table;
+  };
+
+public:
   static TableLineStyle defaultStyle;
 
   Table & add( TableRow tr );
@@ -344,7 +440,7 @@ public:
 
 
   std::ostream & dumpTo( std::ostream & stream ) const;
-  bool empty() const { return _rows.empty(); }
+  bool empty() const { return _rowData.empty() && ! _hasPending; }
 
 
   /** Unsorted - pseudo sort column indicating not to sort. */
@@ -362,13 +458,38 @@ public:
   void sort()					{ sort( unsigned(_defaultSortColumn ) ); }
 
   /** Sort by \a byColumn_r */
-  void sort( unsigned byColumn_r )		{ if ( byColumn_r != Unsorted ) _rows.sort( TableRow::Less( { byColumn_r } ) ); }
-  void sort( const std::list<unsigned> & byColumns_r )	{ if ( byColumns_r.size() ) _rows.sort( TableRow::Less( byColumns_r ) ); }
-  void sort( std::list<unsigned> && byColumns_r )	{ if ( byColumns_r.size() ) _rows.sort( TableRow::Less( std::move(byColumns_r) ) ); }
+  void sort( unsigned byColumn_r )		{ if ( byColumn_r != Unsorted ) sortBy( { byColumn_r } ); }
+  void sort( const std::list<unsigned> & byColumns_r )	{ if ( byColumns_r.size() ) sortBy( byColumns_r ); }
+  void sort( std::list<unsigned> && byColumns_r )	{ if ( byColumns_r.size() ) sortBy( byColumns_r ); }
+
+  /** Custom sort using a \c bool(RowRef,RowRef) less comparator */
+  template<class TCompare, std::enable_if_t<!std::is_integral<TCompare>::value
+                                            && std::is_invocable<TCompare&,RowRef,RowRef>::value, int> = 0>
+  void sort( TCompare && less_r )
+  {
+    store();
+    std::stable_sort( _order.begin(), _order.end(), [this,&less_r]( uint32_t lhs, uint32_t rhs ) {
+      return less_r( RowRef( *this, lhs ), RowRef( *this, rhs ) );
+    } );
+  }
 
-  /** Custom sort */
-  template<class TCompare, std::enable_if_t<!std::is_integral<TCompare>::value, int> = 0>
-  void sort( TCompare && less_r )		{ _rows.sort( std::forward<TCompare>(less_r) ); }
+  /** \overload Custom sort using a \c bool(const TableRow &,const TableRow &) less comparator
+   * The stored rows are copied into \ref TableRow objects for this. Prefer a \ref RowRef comparator.
+   */
+  template<class TCompare, std::enable_if_t<!std::is_integral<TCompare>::value
+                                            && !std::is_invocable<TCompare&,RowRef,RowRef>::value
+                                            && std::is_invocable<TCompare&,const TableRow &,const TableRow &>::value, int> = 0>
+  void sort( TCompare && less_r )
+  {
+    store();
+    std::vector<TableRow> rows;
+    rows.reserve( _rowData.size() );
+    for ( uint32_t idx = 0; idx < _rowData.size(); ++idx )
+      rows.push_back( storedRow( idx ) );
+    std::stable_sort( _order.begin(), _order.end(), [&rows,&less_r]( uint32_t lhs, uint32_t rhs ) {
+      return less_r( rows[lhs], rows[rhs] );
+    } );
+  }
 
   void lineStyle( TableLineStyle st );
   void wrap( int force_break_after = -1 );
@@ -377,10 +498,21 @@ public:
 
   const TableHeader & header() const
   { return _header; }
-  const container & rows() const
-  { return _rows; }
-  container & rows()
-  { return _rows; }
+
+  /** The stored rows in display order. */
+  Rows rows() const
+  { store(); return Rows( *this ); }
+
+  /** The row added last, e.g. to append details or to adjust its columns.
+   * \throws zypp::Exception if the table is empty
+   */
+  TableRow & lastRow();
+
+  /** The row at display position \a pos_r (as in \ref rows), to adjust it.
+   * Like \ref lastRow it stays a \ref TableRow until the next row is added.
+   * \throws zypp::Exception if \a pos_r is out of range
+   */
+  TableRow & row( size_t pos_r );
 
   Table();
 
@@ -389,12 +521,103 @@ public:
   { _editionStyle.insert( column ); }
 
 private:
+  /** A string stored in the \ref Arena and its \ref TableRow::ColumnWidth.
+   * Within a table, \c _interned cells are equal iff their \c _text pointers are equal.
+   */
+  struct Cell
+  {
+    boost::string_ref text() const
+    { return boost::string_ref( _text, _size ); }
+
+    const char * _text;
+    uint32_t _size;
+    uint32_t _width : 30;
+    uint32_t _ascii : 1;
+    uint32_t _interned : 1;
+  };
+
+  /** Per column: whether its values repeat often enough to be interned. */
+  struct InternStats
+  {
+    uint32_t _seen = 0;
+    uint32_t _added = 0;
+  };
+
+  /** A stored row: its ranges in \c _cells and \c _detailCells. */
+  struct RowData
+  {
+    uint32_t _cells;
+    uint32_t _details;
+    uint32_t _ncells;
+    uint32_t _ndetails;
+    ColorContext _ctxt;
+  };
+
+  /** Append-only storage for the cell strings; stored strings never move.
+   * Short column values (status, repo, arch, kind...) repeat a lot. They are
+   * interned, so equal ones share the same storage and their measured width.
+   * Columns with mostly distinct values (names, versions) stop being interned.
+   */
+  class Arena
+  {
+  public:
+    /** Max. size of an interned string. */
+    static constexpr size_t internMax = 64;
+
+    const char * add( boost::string_ref text_r );
+    /** The interned \ref Cell for \a text_r (<= \ref internMax); added and measured if new (\a added_r). */
+    const Cell & intern( boost::string_ref text_r, bool & added_r );
+
+    struct Hash
+    { size_t operator()( boost::string_ref str_r ) const; };
+
+  private:
+    std::vector<std::unique_ptr<char[]>> _chunks;
+    char * _next = nullptr;
+    size_t _avail = 0;
+    std::unordered_map<boost::string_ref, Cell, Hash> _interned;
+  };
+
+  struct TableRowCells;
+  struct StoredCells;
+
+  /** Move the pending \ref lastRow into the columnar storage. */
+  void store() const;
+  /** Take the stored row at display position \a pos_r out of the storage again. */
+  void reopen( size_t pos_r );
+  /** A copy of the stored row \a idx_r. */
+  TableRow storedRow( uint32_t idx_r ) const;
+  Cell storeCell( const std::string & text_r, bool measure_r ) const;
+  Cell storeColumnCell( const std::string & text_r, unsigned col_r ) const;
+
+  void sortBy( const std::list<unsigned> & byColumns_r );
+  void rankColumn( unsigned col_r, std::vector<uint32_t> & ranks_r ) const;
+  void rankUserData( const std::vector<uint32_t> & rows_r, std::vector<uint32_t> & ranks_r ) const;
+
+  template <class TCells>
+  std::ostream & dumpRow( std::ostream & stream, const TCells & cells_r ) const;
   void dumpRule( std::ostream & stream ) const;
-  void updateColWidths( const TableRow & tr ) const;
+  /** Adjust abbreviated columns and print the header */
+  void dumpHeader( std::ostream & stream ) const;
+  template <class TCells>
+  void updateColWidths( const TCells & cells_r ) const;
+  void updateHeaderWidths() const;
 
   bool _has_header;
   TableHeader _header;
-  container _rows;
+
+  // Columnar row storage; rows are addressed by their index in _rowData.
+  // The row added last is kept as TableRow until the next one is added.
+  mutable std::shared_ptr<Arena> _arena;	///< shared by copies; append-only
+  mutable std::vector<Cell> _cells;
+  mutable std::vector<Cell> _detailCells;
+  mutable std::vector<RowData> _rowData;
+  mutable std::vector<boost::any> _userData;
+  mutable std::vector<uint32_t> _order;	///< display order of _rowData indices
+  mutable std::vector<InternStats> _internStats;
+  mutable TableRow _pending;
+  mutable bool _hasPending;
+  mutable size_t _pendingPos;	///< display position of a reopened lastRow
 
   //! maximum column index seen in this table
   mutable unsigned _max_col;
@@ -424,6 +647,7 @@ private:
   { return _editionStyle.find( column ) != _editionStyle.end(); }
 
   friend class TableRow;
+  friend class StreamingTable;
 };
 
 namespace table
@@ -467,6 +691,58 @@ inline std::ostream & operator<<( std::ostream & stream, const Table & table )
 { return table.dumpTo( stream ); }
 
 
+///////////////////////////////////////////////////////////////////
+/// \class StreamingTable
+/// \brief Print \ref Table rows as they are produced.
+///
+/// Unlike \ref Table, rows are not stored. The column widths must be
+/// known before the first row is printed, so the rows are passed twice:
+/// first all of them to \ref measure, then all of them to \ref print in
+/// the same order. The output is the same a \ref Table would print, but
+/// memory does not grow with the number of rows. Sorting is up to the
+/// caller (e.g. sort lightweight handles and create the rows on the fly).
+///
+/// Instead of whole rows, the 1st pass may \ref measure single cells
+/// while the rows' data are collected, so each row is built only once.
+///
+/// Header, line style, abbreviation etc. are set on the \ref table.
+///
+/// \code
+///   StreamingTable stbl( cout );
+///   stbl.table() << ( TableHeader() << N_("Name") );
+///   for ( const auto & el : list ) stbl.measure( TableRow() << el.name() );
+///   for ( const auto & el : list ) stbl.print( TableRow() << el.name() );
+/// \endcode
+///////////////////////////////////////////////////////////////////
+class StreamingTable
+{
+public:
+  explicit StreamingTable( std::ostream & stream_r );
+
+  /** The Table providing header and layout (it holds no rows). */
+  Table & table()
+  { return _table; }
+
+  /** 1st pass: take \a row_r into account when computing the column widths. */
+  void measure( const TableRow & row_r );
+
+  /** 1st pass: take the cell \a text_r in column \a col_r into account.
+   * Like measuring rows having a cell in every measured column.
+   */
+  void measure( unsigned col_r, boost::string_ref text_r );
+
+  /** 2nd pass: print \a row_r (the header is printed before the 1st row). */
+  void print( const TableRow & row_r );
+
+private:
+  std::ostream & _stream;
+  Table _table;
+  std::vector<TableRow::ColumnWidth> _cellWidths;	///< max. widths of cells measured one by one
+  bool _measuring;
+  bool _printing;
+};
+
+
 ///////////////////////////////////////////////////////////////////
 /// \class PropertyTable
 /// \brief Aligned key/value with multiline support
@@ -562,14 +838,14 @@ public:
     if ( cond_r )
     {
       // FIXME re-coloring like this works only once
-      std::string & lastval( _table.rows().back().columns().back() );
+      std::string & lastval( _table.lastRow().columns().back() );
       lastval = ColorString( lastval, color_r ).str();
     }
     return *this;
   }
 
   TableRow & last()
-  { return _table.rows().back(); }
+  { return _table.lastRow(); }
 
   std::string & lastKey()
   { return last().columns()[0]; }
@@ -0,0 +1,227 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include <zypp/base/Easy.h>
+#include <zypp/base/Logger.h>
+#include <zypp/base/String.h>
+#include <zypp/base/Exception.h>
+#include <zypp/sat/Pool.h>
+#include <zypp/CheckSum.h>
+#include <zypp/Digest.h>
+
+#include "main.h"
+#include "TransactionPlan.h"
+
+using namespace zypp;
+
+namespace
+{
+  const char * installTag = "install";
+  const char * removeTag  = "remove";
+  const char * fingerprintTag = "fingerprint";
+  const char * userTag   = "user";
+  const char * solverTag = "solver";
+
+  std::string checksumString( const PoolItem & pi_r )
+  {
+    CheckSum checksum( pi_r.satSolvable().lookupCheckSumAttribute( sat::SolvAttr::checksum ) );
+    return( checksum.empty() ? std::string() : checksum.type() + ":" + checksum.checksum() );
+  }
+
+  inline std::string stepLabel( const TransactionPlan::Step & step_r )
+  { return step_r._name + "-" + step_r._edition + "." + step_r._arch; }
+
+  /** TAB separated fields, empty ones included. */
+  std::vector<std::string> splitFields( const std::string & line_r )
+  {
+    std::vector<std::string> ret;
+    std::istringstream str( line_r );
+    std::string field;
+    while ( std::getline( str, field, '\t' ) )
+      ret.push_back( field );
+    return ret;
+  }
+} // namespace
+
+TransactionPlan TransactionPlan::fromPool( const ResPool & pool_r )
+{
+  TransactionPlan ret;
+  ret.setFingerprint( poolFingerprint( pool_r ) );
+  for ( const PoolItem & pi : pool_r )
+  {
+    if ( ! pi.status().transacts() )
+      continue;
+
+    Step step;
+    step._action = pi.status().isToBeInstalled() ? Step::Install : Step::Remove;
+    step._causer = pi.status().isByUser() ? Step::User : Step::Solver;
+    step._kind = pi.kind().asString();
+    step._name = pi.name();
+    step._edition = pi.edition().asString();
+    step._arch = pi.arch().asString();
+    step._repo = pi.repository().alias();
+    step._checksum = checksumString( pi );
+    ret.addStep( std::move(step) );
+  }
+  return ret;
+}
+
+std::string TransactionPlan::poolFingerprint( const ResPool & pool_r )
+{
+  // The repos are sorted, their order in the pool depends on the priorities.
+  // A repo is identified by its metadata timestamp, not its content (this is
+  // what the refresh uses to decide whether it changed). The installed
+  // packages are compared in full: they differ most between hosts.
+  std::vector<std::string> lines;
+  for ( const sat::Repository & repo : sat::Pool::instance().repos() )
+  {
+    if ( repo.isSystemRepo() )
+    {
+      for ( const sat::Solvable & solv : repo.solvables() )
+	lines.push_back( str::Str() << "@ " << solv.ident() << " " << solv.edition() << " " << solv.arch() );
+    }
+    else
+      lines.push_back( str::Str() << "repo " << repo.alias() << " " << Date::ValueType(repo.generatedTimestamp()) << " " << repo.solvablesSize() );
+  }
+  std::sort( lines.begin(), lines.end() );
+
+  std::stringstream str;
+  for ( const std::string & line : lines )
+    str << line << "\n";
+  return Digest::digest( Digest::sha256(), str );
+}
+
+TransactionPlan TransactionPlan::read( std::istream & str_r )
+{
+  TransactionPlan ret;
+  std::string line;
+  unsigned lineno = 0;
+  while ( std::getline( str_r, line ) )
+  {
+    ++lineno;
+    if ( line.empty() || line[0] == '#' )
+      continue;
+
+    std::vector<std::string> fields( splitFields( line ) );
+    if ( fields[0] == fingerprintTag && fields.size() == 2 )
+    {
+      ret.setFingerprint( fields[1] );
+      continue;
+    }
+
+    if ( ( fields[0] == installTag || fields[0] == removeTag ) && ( fields.size() >= 6 && fields.size() <= 8 )
+	 && ( fields.size() < 8 || fields[7] == userTag || fields[7] == solverTag ) )
+    {
+      Step step;
+      step._action = ( fields[0] == installTag ? Step::Install : Step::Remove );
+      step._kind = fields[1];
+      step._name = fields[2];
+      step._edition = fields[3];
+      step._arch = fields[4];
+      step._repo = fields[5];
+      if ( fields.size() >= 7 )
+	step._checksum = fields[6];
+      if ( fields.size() == 8 && fields[7] == solverTag )
+	step._causer = Step::Solver;
+      ret.addStep( std::move(step) );
+      continue;
+    }
+
+    // translators: %1% is a line number, %2% the text in that line
+    ZYPP_THROW( Exception( str::Format(_("Malformed plan line %1%: %2%")) % lineno % line ) );
+  }
+
+  if ( ret.fingerprint().empty() )
+    ZYPP_THROW( Exception( _("The plan has no fingerprint.") ) );
+  return ret;
+}
+
+TransactionPlan TransactionPlan::read( const std::string & file_r )
+{
+  std::ifstream str( file_r.c_str() );
+  if ( ! str )
+    ZYPP_THROW( Exception( str::Format(_("Can't open '%1%' for reading.")) % file_r ) );
+  MIL << "Reading plan " << file_r << endl;
+  return read( str );
+}
+
+void TransactionPlan::write( std::ostream & str_r ) const
+{
+  str_r << "# zypper transaction plan" << "\n";
+  str_r << fingerprintTag << "\t" << _fingerprint << "\n";
+  for ( const Step & step : _steps )
+  {
+    str_r << ( step._action == Step::Install ? installTag : removeTag )
+          << "\t" << step._kind
+          << "\t" << step._name
+          << "\t" << step._edition
+          << "\t" << step._arch
+          << "\t" << step._repo
+          << "\t" << step._checksum
+          << "\t" << ( step._causer == Step::User ? userTag : solverTag ) << "\n";
+  }
+}
+
+void TransactionPlan::write( const std::string & file_r ) const
+{
+  std::ofstream str( file_r.c_str(), std::ios_base::out | std::ios_base::trunc );
+  if ( str )
+    write( str );
+  if ( ! str.flush() )
+    ZYPP_THROW( Exception( str::Format(_("Can't open '%1%' for writing.")) % file_r ) );
+  MIL << "Wrote plan with " << _steps.size() << " steps to " << file_r << endl;
+}
+
+bool TransactionPlan::apply( const ResPool & pool_r, std::vector<std::string> & problems_r ) const
+{
+  for ( const Step & step : _steps )
+  {
+    ResKind kind( step._kind );
+    PoolItem found;
+    for_( it, pool_r.byIdentBegin( kind, step._name ), pool_r.byIdentEnd( kind, step._name ) )
+    {
+      const PoolItem & pi( *it );
+      if ( pi.edition().asString() == step._edition
+	&& pi.arch().asString() == step._arch
+	&& pi.repository().alias() == step._repo )
+      {
+	found = pi;
+	break;
+      }
+    }
+
+    if ( ! found )
+    {
+      // translators: %1% is a package like 'vim-9.0.1-1.1.x86_64', %2% a repository alias
+      problems_r.push_back( str::Format(_("%1% was not found in repository '%2%'.")) % stepLabel( step ) % step._repo );
+      continue;
+    }
+
+    if ( step._checksum != checksumString( found ) )
+    {
+      // translators: %1% is a package like 'vim-9.0.1-1.1.x86_64', %2% a repository alias
+      problems_r.push_back( str::Format(_("%1% in repository '%2%' does not match the checksum in the plan.")) % stepLabel( step ) % step._repo );
+      continue;
+    }
+
+    ResStatus::TransactByValue causer = ( step._causer == Step::User ? ResStatus::USER : ResStatus::SOLVER );
+    bool done = ( step._action == Step::Install ? found.status().setToBeInstalled( causer )
+                                                : found.status().setToBeUninstalled( causer ) );
+    if ( ! done )
+    {
+      // translators: %1% is a package like 'vim-9.0.1-1.1.x86_64'
+      problems_r.push_back( str::Format( step._action == Step::Install ? _("%1% can not be installed (locked?).")
+									   : _("%1% can not be removed (locked?).") ) % stepLabel( step ) );
+      continue;
+    }
+    DBG << "Plan: " << found << endl;
+  }
+  return problems_r.empty();
+}
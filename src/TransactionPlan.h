@@ -0,0 +1,102 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+#ifndef ZYPPER_TRANSACTIONPLAN_H
+#define ZYPPER_TRANSACTIONPLAN_H
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include <zypp/ResPool.h>
+
+///////////////////////////////////////////////////////////////////
+/// \class TransactionPlan
+/// \brief A solved transaction saved to a file (--save-plan, apply-plan).
+///
+/// Resolving a big update takes a while and is done over and over again on
+/// hosts with identical repos and installed packages. A plan computed on one
+/// of them can be replayed on the others without solving again.
+///
+/// The plan lists the items to install and to remove (by kind, name,
+/// edition, arch, repo alias and checksum) and the \ref poolFingerprint of
+/// the pool it was computed for. It can only be applied to a pool with the
+/// same fingerprint. Each step also records whether the user requested it
+/// or the solver added it, so the applied items get the same causer.
+///
+/// The file is line based, the fields are separated by TABs:
+/// \code
+/// # zypper transaction plan
+/// fingerprint	<sha256>
+/// install	package	vim	9.0.1-1.1	x86_64	repo-oss	sha256:4f3c...	user
+/// install	package	vim-data	9.0.1-1.1	noarch	repo-oss	sha256:a71e...	solver
+/// remove	package	vim	8.2.4-1.1	x86_64	@System		user
+/// \endcode
+/// A missing causer field (older plans) means \c user.
+///////////////////////////////////////////////////////////////////
+class TransactionPlan
+{
+public:
+  struct Step
+  {
+    enum Action { Install, Remove };
+    enum Causer { User, Solver };
+
+    Action _action = Install;
+    Causer _causer = User;	///< who requested the step
+    std::string _kind;
+    std::string _name;
+    std::string _edition;
+    std::string _arch;
+    std::string _repo;		///< repo alias
+    std::string _checksum;	///< \c type:value, empty if unknown
+  };
+
+public:
+  /** The steps to turn \a pool_r into its current transaction. */
+  static TransactionPlan fromPool( const zypp::ResPool & pool_r );
+
+  /** Identifies the repos and installed packages in \a pool_r.
+   * Repos are identified by alias, timestamp and number of solvables,
+   * installed packages by their NEVRA.
+   */
+  static std::string poolFingerprint( const zypp::ResPool & pool_r );
+
+  /** Read a plan, \throws zypp::Exception if it is malformed. */
+  static TransactionPlan read( std::istream & str_r );
+  static TransactionPlan read( const std::string & file_r );
+
+  /** Write the plan, \throws zypp::Exception if \a file_r can't be written. */
+  void write( std::ostream & str_r ) const;
+  void write( const std::string & file_r ) const;
+
+  /** Set the transact status of the items listed in the plan.
+   * Steps added by the solver are set with causer \c ResStatus::SOLVER,
+   * the others with \c ResStatus::USER.
+   * Items which can't be found or set are described in \a problems_r.
+   * \return whether all steps were applied.
+   */
+  bool apply( const zypp::ResPool & pool_r, std::vector<std::string> & problems_r ) const;
+
+public:
+  const std::string & fingerprint() const
+  { return _fingerprint; }
+
+  void setFingerprint( std::string fingerprint_r )
+  { _fingerprint = std::move(fingerprint_r); }
+
+  const std::vector<Step> & steps() const
+  { return _steps; }
+
+  void addStep( Step step_r )
+  { _steps.push_back( std::move(step_r) ); }
+
+private:
+  std::string _fingerprint;
+  std::vector<Step> _steps;
+};
+
+#endif // ZYPPER_TRANSACTIONPLAN_H
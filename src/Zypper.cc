@@ -32,6 +32,7 @@
 #include <zypp/PoolQuery.h>
 #include <zypp/Locks.h>
 #include <zypp/Edition.h>
+#include <zypp/ByteCount.h>
 
 #include <zypp/target/rpm/RpmHeader.h> // for install <.rpmURI>
 
@@ -46,6 +47,8 @@
 #include "utils/messages.h"
 #include "utils/getopt.h"
 #include "utils/misc.h"
+#include "utils/PhaseProfile.h"
+#include "utils/TraceFile.h"
 
 #include "repos.h"
 #include "update.h"
@@ -68,6 +71,83 @@ using namespace zypp;
 
 bool sigExitOnce = true;	// Flag to prevent nested calls to Zypper::immediateExit
 
+///////////////////////////////////////////////////////////////////
+namespace out
+{
+  /** The --profile report. */
+  struct ProfileTableFormater : public TableFormater
+  {
+    static std::string seconds( std::chrono::microseconds val_r )
+    { return str::form( "%.3f", val_r.count() / 1000000.0 ); }
+
+    static std::string bytes( long long val_r )
+    { return( val_r < 0 ? std::string( "?" ) : ByteCount( val_r ).asString() ); }
+
+    std::string xmlListElement( const PhaseProfile::Phase & phase_r ) const
+    {
+      str::Str str;
+      xmlout::node( str.stream(), "phase", {
+	{ "name",	phase_r._name },
+	{ "depth",	phase_r._depth },
+	{ "count",	phase_r._count },
+	{ "wall",	seconds( std::chrono::duration_cast<std::chrono::microseconds>( phase_r._wall ) ) },
+	{ "cpu",	seconds( phase_r._cpu ) },
+	{ "rss",	phase_r._rss * 1024 },
+	{ "read",	phase_r._read },
+	{ "written",	phase_r._written },
+      } );
+      return str;
+    }
+
+    TableHeader header() const
+    {
+      return ( TableHeader()
+	// translators: --profile table header; a part of zyppers work like "resolve" or "download"
+	<< N_("Phase")
+	// translators: --profile table header; elapsed real time in seconds
+	<< N_("Wall (s)")
+	// translators: --profile table header; processor time used in seconds
+	<< N_("CPU (s)")
+	// translators: --profile table header; how much the peak memory usage grew
+	<< N_("Peak RSS")
+	// translators: --profile table header; bytes read from disk
+	<< N_("Read")
+	// translators: --profile table header; bytes written to disk
+	<< N_("Written") );
+    }
+
+    TableRow row( const PhaseProfile::Phase & phase_r ) const
+    {
+      return ( TableRow()
+	<< std::string( 2 * phase_r._depth, ' ' ) + phase_r._name
+	<< seconds( std::chrono::duration_cast<std::chrono::microseconds>( phase_r._wall ) )
+	<< seconds( phase_r._cpu )
+	<< bytes( phase_r._rss * 1024 )
+	<< bytes( phase_r._read )
+	<< bytes( phase_r._written ) );
+    }
+  };
+} // namespace out
+///////////////////////////////////////////////////////////////////
+namespace
+{
+  /** Write the --profile report (if enabled). */
+  void reportProfile( Out & out_r )
+  {
+    PhaseProfile & profile( PhaseProfile::instance() );
+    if ( ! profile.enabled() )
+      return;
+    profile.stopAll();
+    std::vector<PhaseProfile::Phase> phases( profile.phases() );
+    for ( const PhaseProfile::Phase & phase : phases )
+      MIL << "Profile " << phase._name << ": " << std::chrono::duration_cast<std::chrono::milliseconds>( phase._wall ).count() << "ms" << endl;
+
+    out_r.gap();
+    out_r.table( "profile", _("Profile:"), phases, out::ProfileTableFormater() );
+  }
+} // namespace
+///////////////////////////////////////////////////////////////////
+
 ZYpp::Ptr God = NULL;
 void Zypper::assertZYppPtrGod()
 {
@@ -252,6 +332,9 @@ int Zypper::main( int argc, char ** argv )
       setExitCode( ZYPPER_EXIT_ERR_BUG );
   }
 
+  if ( _out_ptr )
+    reportProfile( *_out_ptr );
+  TraceFile::instance().close();
   return exitCode();
 }
 
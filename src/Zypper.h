@@ -49,6 +49,14 @@ struct Options;
  */
 #define ZYPPER_RPM_CACHE_DIR "/var/cache/zypper/RPMS"
 
+/** directory for storing the results of read-only queries (lu, lp, pchk)
+ */
+#define ZYPPER_QUERY_CACHE_DIR "/var/cache/zypper/query"
+
+/** index of the patch status changes found in the history log
+ */
+#define ZYPPER_HISTORY_INDEX_FILE "/var/cache/zypper/history.index"
+
 inline std::string dashdash( std::string optname_r )
 { return optname_r.insert( 0, "--" ); }
 
@@ -10,6 +10,8 @@
 
 #include <stdlib.h>
 #include <ctime>
+#include <map>
+#include <mutex>
 
 #include <zypp/ZYppCallbacks.h>
 #include <zypp/base/Logger.h>
@@ -17,6 +19,8 @@
 #include <zypp/Url.h>
 
 #include "Zypper.h"
+#include "utils/PhaseProfile.h"
+#include "utils/TraceFile.h"
 
 // auto-repeat counter limit
 #define REPEAT_LIMIT 3
@@ -90,45 +94,60 @@ namespace ZmartRecipients
   };
 
   // progress for downloading a file
+  // The state is kept per Url, as downloads may be in progress concurrently
+  // (and the callbacks may arrive from different threads).
   struct DownloadProgressReportReceiver : public ExitGuardedReceiveReport<media::DownloadProgressReport>
   {
-    DownloadProgressReportReceiver()
-      : _be_quiet(false)
-    {}
-
     virtual void start( const Url & uri, Pathname localfile )
     {
-      _last_reported = time(NULL);
-      _last_drate_avg = -1;
-
       Out & out = Zypper::instance().out();
 
-      if (out.verbosity() < Out::HIGH &&
+      bool be_quiet = ( out.verbosity() < Out::HIGH &&
            (
              // don't show download info unless show_media_progress_hack is used
              !Zypper::instance().runtimeData().show_media_progress_hack ||
              // don't report download of the media file (bnc #330614)
              Pathname(uri.getPathName()).basename() == "media"
            )
-         )
+         );
       {
-        _be_quiet = true;
-        return;
+	std::lock_guard<std::mutex> guard( _mutex );
+	auto ins = _states.emplace( uri.asString(), State() );
+	if ( ins.second )
+	{
+	  PhaseProfile::instance().start( "download" );	// concurrent downloads nest
+	  if ( TraceFile::instance().isOpen() )
+	    TraceFile::instance().begin( uri.asString(), Pathname(uri.getPathName()).basename(), "download", { { "url", uri.asString() } } );
+	}
+	State & state( ins.first->second );
+	state._be_quiet = be_quiet;
+	state._last_reported = time(NULL);
+	state._last_drate_avg = -1;
       }
-      else
-        _be_quiet = false;
+      if ( be_quiet )
+        return;
 
       out.dwnldProgressStart(uri);
     }
 
     virtual bool progress(int value, const Url & uri, double drate_avg, double drate_now)
     {
-      // don't report more often than 1 second
-      time_t now = time(NULL);
-      if (now > _last_reported)
-        _last_reported = now;
-      else
-        return !Zypper::instance().exitRequested();
+      bool be_quiet;
+      {
+	std::lock_guard<std::mutex> guard( _mutex );
+	auto it = _states.find( uri.asString() );
+	if ( it == _states.end() )
+	  return !Zypper::instance().exitRequested();	// start() not seen
+	State & state( it->second );
+	// don't report more often than 1 second
+	time_t now = time(NULL);
+	if (now > state._last_reported)
+	  state._last_reported = now;
+	else
+	  return !Zypper::instance().exitRequested();
+	state._last_drate_avg = drate_avg;
+	be_quiet = state._be_quiet;
+      }
 
       Zypper & zypper( Zypper::instance() );
 
@@ -142,11 +161,10 @@ namespace ZmartRecipients
         zypper.out().progress(
           "raw-refresh", zypper.runtimeData().raw_refresh_progress_label);
 
-      if (_be_quiet)
+      if (be_quiet)
         return true;
 
       zypper.out().dwnldProgress(uri, value, (long) drate_now);
-      _last_drate_avg = drate_avg;
       return true;
     }
 
@@ -154,8 +172,9 @@ namespace ZmartRecipients
     problem( const Url & uri, DownloadProgressReport::Error error, const std::string & description )
     {
       DBG << "media problem" << std::endl;
-      if (_be_quiet)
-        Zypper::instance().out().dwnldProgressEnd(uri, _last_drate_avg, true);
+      State state( lookup( uri ) );
+      if (state._be_quiet)
+        Zypper::instance().out().dwnldProgressEnd(uri, state._last_drate_avg, true);
       Zypper::instance().out().error(zcb_error2str(error, description));
 
       Action action = (Action) read_action_ari(
@@ -168,17 +187,42 @@ namespace ZmartRecipients
     // used only to finish, errors will be reported in media change callback (libzypp 3.20.0)
     virtual void finish( const Url & uri, Error error, const std::string & konreason )
     {
-      if (_be_quiet)
+      State state;
+      {
+	std::lock_guard<std::mutex> guard( _mutex );
+	auto it = _states.find( uri.asString() );
+	if ( it != _states.end() )
+	{
+	  state = it->second;
+	  _states.erase( it );
+	  PhaseProfile::instance().stop( "download" );
+	  TraceFile::instance().end( uri.asString(), { { "error", str::numstring( static_cast<int>(error) ) } } );
+	}
+      }
+      if (state._be_quiet)
         return;
 
       Zypper::instance().out().dwnldProgressEnd(
-          uri, _last_drate_avg, ( error == NOT_FOUND ? indeterminate : TriBool(error != NO_ERROR) ) );
+          uri, state._last_drate_avg, ( error == NOT_FOUND ? indeterminate : TriBool(error != NO_ERROR) ) );
     }
 
   private:
-    bool _be_quiet;
-    time_t _last_reported;
-    double _last_drate_avg;
+    struct State
+    {
+      bool _be_quiet = false;
+      time_t _last_reported = 0;
+      double _last_drate_avg = -1;
+    };
+
+    State lookup( const Url & uri_r )
+    {
+      std::lock_guard<std::mutex> guard( _mutex );
+      auto it = _states.find( uri_r.asString() );
+      return( it == _states.end() ? State() : it->second );
+    }
+
+    std::mutex _mutex;
+    std::map<std::string,State> _states;	///< per active download
   };
 
 
@@ -25,6 +25,8 @@
 #include "Zypper.h"
 #include "output/prompt.h"
 #include "global-settings.h"
+#include "utils/PhaseProfile.h"
+#include "utils/TraceFile.h"
 
 ///////////////////////////////////////////////////////////////////
 namespace
@@ -60,6 +62,21 @@ namespace
     }
   }
 
+  /** --trace-file: an rpm step (\a action_r is "install" or "remove"). */
+  inline void traceBegin( const std::string & action_r, const Resolvable::constPtr & resolvable_r )
+  {
+    TraceFile & trace( TraceFile::instance() );
+    if ( trace.isOpen() )
+      trace.begin( resolvable_r->asString(), action_r + " " + resolvable_r->asString(), "rpm", { { "action", action_r } } );
+  }
+
+  inline void traceEnd( const Resolvable::constPtr & resolvable_r, int error_r )
+  {
+    TraceFile & trace( TraceFile::instance() );
+    if ( trace.isOpen() )
+      trace.end( resolvable_r->asString(), { { "error", str::numstring( error_r ) } } );
+  }
+
 } // namespace
 ///////////////////////////////////////////////////////////////////
 
@@ -246,10 +263,14 @@ struct PatchScriptReportReceiver : public callback::ReceiveReport<target::PatchS
  // progress for removing a resolvable
 struct RemoveResolvableReportReceiver : public callback::ReceiveReport<target::rpm::RemoveResolvableReport>
 {
+  virtual void reportbegin()
+  { PhaseProfile::instance().start( "rpm" ); }
+
   virtual void start( Resolvable::constPtr resolvable )
   {
     ++Zypper::instance().runtimeData().rpm_pkg_current;
     showProgress( resolvable );
+    traceBegin( "remove", resolvable );
   }
 
   virtual bool progress( int value, Resolvable::constPtr resolvable )
@@ -280,8 +301,9 @@ struct RemoveResolvableReportReceiver : public callback::ReceiveReport<target::r
     return ret;
   }
 
-  virtual void finish( Resolvable::constPtr /*resolvable*/, Error error, const std::string & reason )
+  virtual void finish( Resolvable::constPtr resolvable, Error error, const std::string & reason )
   {
+    traceEnd( resolvable, error );
     // finsh progress; indicate error
     if ( _progress )
     {
@@ -300,7 +322,10 @@ struct RemoveResolvableReportReceiver : public callback::ReceiveReport<target::r
   }
 
   virtual void reportend()
-  { _progress.reset(); }
+  {
+    _progress.reset();
+    PhaseProfile::instance().stop( "rpm" );
+  }
 
 private:
   void showProgress( Resolvable::constPtr resolvable_r )
@@ -323,10 +348,14 @@ private:
 // progress for installing a resolvable
 struct InstallResolvableReportReceiver : public callback::ReceiveReport<target::rpm::InstallResolvableReport>
 {
+  virtual void reportbegin()
+  { PhaseProfile::instance().start( "rpm" ); }
+
   virtual void start( Resolvable::constPtr resolvable )
   {
     ++Zypper::instance().runtimeData().rpm_pkg_current;
     showProgress( resolvable );
+    traceBegin( "install", resolvable );
   }
 
   virtual bool progress( int value, Resolvable::constPtr resolvable )
@@ -357,8 +386,9 @@ struct InstallResolvableReportReceiver : public callback::ReceiveReport<target::
     return ret;
   }
 
-  virtual void finish( Resolvable::constPtr /*resolvable*/, Error error, const std::string & reason, RpmLevel /*unused*/ )
+  virtual void finish( Resolvable::constPtr resolvable, Error error, const std::string & reason, RpmLevel /*unused*/ )
   {
+    traceEnd( resolvable, error );
     // finsh progress; indicate error
     if ( _progress )
     {
@@ -377,7 +407,10 @@ struct InstallResolvableReportReceiver : public callback::ReceiveReport<target::
   }
 
   virtual void reportend()
-  { _progress.reset(); }
+  {
+    _progress.reset();
+    PhaseProfile::instance().stop( "rpm" );
+  }
 
 private:
   void showProgress( Resolvable::constPtr resolvable_r )
@@ -416,6 +449,8 @@ struct FindFileConflictstReportReceiver : public callback::ReceiveReport<target:
 
   virtual void reportbegin()
   {
+    PhaseProfile::instance().start( "file_conflicts" );
+    TraceFile::instance().begin( "file_conflicts", "file_conflicts", TraceFile::mainCategory );
     Zypper::instance().out().gap();
     _lastskip = 0;
     _progress.reset( new Out::ProgressBar( Zypper::instance().out(),
@@ -502,7 +537,11 @@ struct FindFileConflictstReportReceiver : public callback::ReceiveReport<target:
   }
 
   virtual void reportend()
-  { _progress.reset(); }
+  {
+    _progress.reset();
+    PhaseProfile::instance().stop( "file_conflicts" );
+    TraceFile::instance().end( "file_conflicts" );
+  }
 
 private:
   scoped_ptr<Out::ProgressBar>	_progress;
@@ -514,12 +553,16 @@ private:
  // progress for removing a resolvable during a single transaction
 struct RemoveResolvableSAReportReceiver : public callback::ReceiveReport<target::rpm::RemoveResolvableReportSA>
 {
+  void reportbegin() override
+  { PhaseProfile::instance().start( "rpm" ); }
+
   void start(
           Resolvable::constPtr resolvable,
           const UserData & /*userdata*/ ) override
   {
     ++Zypper::instance().runtimeData().rpm_pkg_current;
     showProgress( resolvable );
+    traceBegin( "remove", resolvable );
   }
 
   void progress(
@@ -531,8 +574,9 @@ struct RemoveResolvableSAReportReceiver : public callback::ReceiveReport<target:
       (*_progress)->set( value );
   }
 
-  void finish( Resolvable::constPtr /*resolvable*/, Error error, const UserData & /*userdata*/ ) override
+  void finish( Resolvable::constPtr resolvable, Error error, const UserData & /*userdata*/ ) override
   {
+    traceEnd( resolvable, error );
     // finsh progress; indicate error
     if ( _progress )
     {
@@ -562,7 +606,10 @@ struct RemoveResolvableSAReportReceiver : public callback::ReceiveReport<target:
   }
 
   void reportend() override
-  { _progress.reset(); }
+  {
+    _progress.reset();
+    PhaseProfile::instance().stop( "rpm" );
+  }
 
 private:
   void showProgress( Resolvable::constPtr resolvable_r )
@@ -585,10 +632,14 @@ private:
 // progress for installing a resolvable during a single transaction
 struct InstallResolvableSAReportReceiver : public callback::ReceiveReport<target::rpm::InstallResolvableReportSA>
 {
+  void reportbegin() override
+  { PhaseProfile::instance().start( "rpm" ); }
+
   void start( Resolvable::constPtr resolvable, const UserData & /*userdata*/ ) override
   {
     ++Zypper::instance().runtimeData().rpm_pkg_current;
     showProgress( resolvable );
+    traceBegin( "install", resolvable );
   }
 
   void progress( int value, Resolvable::constPtr resolvable, const UserData & /*userdata*/ ) override
@@ -597,8 +648,9 @@ struct InstallResolvableSAReportReceiver : public callback::ReceiveReport<target
       (*_progress)->set( value );
   }
 
-  void finish( Resolvable::constPtr /*resolvable*/, Error error, const UserData & /*userdata*/ ) override
+  void finish( Resolvable::constPtr resolvable, Error error, const UserData & /*userdata*/ ) override
   {
+    traceEnd( resolvable, error );
     // finsh progress; indicate error
     if ( _progress )
     {
@@ -628,7 +680,10 @@ struct InstallResolvableSAReportReceiver : public callback::ReceiveReport<target
   }
 
   void reportend() override
-  { _progress.reset(); }
+  {
+    _progress.reset();
+    PhaseProfile::instance().stop( "rpm" );
+  }
 
 private:
   void showProgress( Resolvable::constPtr resolvable_r )
@@ -0,0 +1,103 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+#include "applyplan.h"
+#include "commands/conditions.h"
+#include "solve-commit.h"
+#include "utils/messages.h"
+#include "commonflags.h"
+#include "TransactionPlan.h"
+
+#include "Zypper.h"
+
+ApplyPlanCmd::ApplyPlanCmd( std::vector<std::string> &&commandAliases_r ) :
+  ZypperBaseCommand (
+    std::move( commandAliases_r ),
+    // translators: command synopsis; do not translate lowercase words
+    _("apply-plan [OPTIONS] <FILE>"),
+    // translators: command summary: apply-plan
+    _("Apply a saved transaction plan."),
+    // translators: command description
+    _("Install and remove the packages listed in a transaction plan saved by the '--save-plan' option of 'install', 'update', 'patch' or 'dist-upgrade', without solving again. The plan is applied only if the repositories and installed packages are the same as on the host which saved it."),
+    ResetRepoManager | InitTarget | InitRepos | LoadResolvables
+  )
+{}
+
+zypp::ZyppFlags::CommandGroup ApplyPlanCmd::cmdOptions() const
+{
+  auto that = const_cast<ApplyPlanCmd *>(this);
+  return zypp::ZyppFlags::CommandGroup({
+    CommonFlags::detailsFlag( that->_details )
+  });
+}
+
+void ApplyPlanCmd::doReset()
+{
+  _details = false;
+}
+
+std::vector<BaseCommandConditionPtr> ApplyPlanCmd::conditions() const
+{
+  return {
+    std::make_shared<NeedsRootCondition>(),
+    std::make_shared<NeedsWritableRoot>()
+  };
+}
+
+int ApplyPlanCmd::execute( Zypper &zypper, const std::vector<std::string> &positionalArgs_r )
+{
+  if ( positionalArgs_r.size() > 1 )
+  {
+    report_too_many_arguments( help() );
+    return ( ZYPPER_EXIT_ERR_INVALID_ARGS );
+  }
+  if ( positionalArgs_r.empty() )
+  {
+    report_required_arg_missing( zypper.out(), help() );
+    return ( ZYPPER_EXIT_ERR_INVALID_ARGS );
+  }
+
+  TransactionPlan plan;
+  try
+  {
+    plan = TransactionPlan::read( positionalArgs_r[0] );
+  }
+  catch ( const Exception & e )
+  {
+    ZYPP_CAUGHT( e );
+    zypper.out().error( e, str::Format(_("Failed to read the transaction plan '%1%'.")) % positionalArgs_r[0] );
+    return ( ZYPPER_EXIT_ERR_INVALID_ARGS );
+  }
+
+  ResPool pool( ResPool::instance() );
+  if ( plan.fingerprint() != TransactionPlan::poolFingerprint( pool ) )
+  {
+    zypper.out().error( _("The transaction plan was saved for different repositories or installed packages."),
+			str::Format(_("Refresh the repositories or save a new plan with '%1%'.")) % "--save-plan" );
+    return ( ZYPPER_EXIT_ERR_ZYPP );
+  }
+
+  std::vector<std::string> problems;
+  if ( ! plan.apply( pool, problems ) )
+  {
+    for ( const std::string & problem : problems )
+      zypper.out().error( problem );
+    return ( ZYPPER_EXIT_ERR_ZYPP );
+  }
+  MIL << "Applied plan with " << plan.steps().size() << " steps" << endl;
+
+  Summary::ViewOptions viewOpts = Summary::DEFAULT;
+  if ( _details )
+    viewOpts = static_cast<Summary::ViewOptions>( viewOpts | Summary::DETAILS );
+
+  // The plan is the solver result, no need to solve again.
+  zypper.runtimeData().solve_before_commit = false;
+  auto policy = SolveAndCommitPolicy( ).summaryOptions( viewOpts ).downloadMode( _downloadModeOpts.mode() );
+  // Downgrades were accepted when the plan was saved.
+  policy.zyppCommitPolicy().allowDowngrade( true );
+  solve_and_commit( zypper, policy );
+  return zypper.exitCode();
+}
@@ -0,0 +1,34 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+#ifndef ZYPPER_COMMANDS_APPLYPLAN_INCLUDED
+#define ZYPPER_COMMANDS_APPLYPLAN_INCLUDED
+
+#include "commands/basecommand.h"
+#include "commands/optionsets.h"
+
+class ApplyPlanCmd : public ZypperBaseCommand
+{
+public:
+  ApplyPlanCmd( std::vector<std::string> &&commandAliases_r );
+
+private:
+  bool _details = false;
+  FileConflictPolicyOptionSet _fileConflictOpts { *this };
+  LicensePolicyOptionSet _licensePolicyOpts { *this };
+  DryRunOptionSet _dryRunOpts { *this };
+  NoConfirmRugOption _noConfirmOpts { *this };
+  DownloadOptionSet _downloadModeOpts { *this };
+
+  // ZypperBaseCommand interface
+protected:
+  zypp::ZyppFlags::CommandGroup cmdOptions() const override;
+  void doReset() override;
+  int execute(Zypper &zypper, const std::vector<std::string> &positionalArgs_r) override;
+  std::vector<BaseCommandConditionPtr> conditions() const override;
+};
+
+#endif
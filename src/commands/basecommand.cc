@@ -7,6 +7,8 @@
 #include "commandhelpformatter.h"
 #include "solve-commit.h"
 #include "global-settings.h"
+#include "utils/misc.h"
+#include "utils/PhaseProfile.h"
 
 #include "src/repos.h"
 
@@ -166,13 +168,19 @@ int ZypperBaseCommand::defaultSystemSetup( Zypper &zypper, SetupSystemFlags flag
     zypper.initRepoManager();
 
   if ( flags_r.testFlag( InitTarget ) ) {
-    init_target( zypper );
+    {
+      PhaseProfile::Scope profile( "init_target" );
+      init_target( zypper );
+    }
     if ( zypper.exitCode() != ZYPPER_EXIT_OK )
       return zypper.exitCode();
   }
 
   if ( flags_r.testFlag( InitRepos ) ) {
-    init_repos( zypper );
+    {
+      PhaseProfile::Scope profile( "init_repos" );
+      init_repos( zypper );
+    }
     if ( zypper.exitCode() != ZYPPER_EXIT_OK )
       return zypper.exitCode();
   }
@@ -183,10 +191,13 @@ int ZypperBaseCommand::defaultSystemSetup( Zypper &zypper, SetupSystemFlags flag
   }
 
   if ( flags_r.testFlag( LoadResolvables ) ) {
+    PhaseProfile::Scope profile( "load_resolvables" );
     load_resolvables( zypper );
   } else if ( flags_r.testFlag( LoadRepoResolvables ) ) {
+    PhaseProfile::Scope profile( "load_resolvables" );
     load_repo_resolvables( zypper );
   } else if ( flags_r.testFlag( LoadTargetResolvables ) ) {
+    PhaseProfile::Scope profile( "load_resolvables" );
     load_target_resolvables( zypper );
   }
 
@@ -198,8 +209,10 @@ int ZypperBaseCommand::defaultSystemSetup( Zypper &zypper, SetupSystemFlags flag
     // compute status of PPP
     MIL << "-------------- Calling SAT Solver to establish the PPP status -------------------" << endl;
     base::LogControl::TmpLineWriter shutUp;	// reduce logging; some day libzypp/libsolv may offer a shotcut to establish
+    PhaseProfile::Scope profile( "resolve" );
     resolve( zypper );
   }
+  StatusIndicatorCache::instance().clear();	// items status may have changed
 
   return zypper.exitCode();
 }
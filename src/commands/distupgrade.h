@@ -24,6 +24,7 @@ private:
   DryRunOptionSet _dryRunOpts { *this };
   NoConfirmRugOption _noConfirmOpts { *this };
   DownloadOptionSet _downloadModeOpts { *this };
+  SavePlanOptionSet _savePlanOpts { *this };
   SolverCommonOptionSet _commonSolverOpts { *this };
   SolverRecommendsOptionSet _recommendsSolverOpts { *this };
   SolverInstallsOptionSet _installSolverOpts { *this };
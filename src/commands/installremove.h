@@ -70,6 +70,7 @@ private:
   FileConflictPolicyOptionSet _fileConflictOpts { *this };
   LicensePolicyOptionSet _licensePolicy { *this };
   DownloadOptionSet _downloadMode { *this };
+  SavePlanOptionSet _savePlanOpts { *this };
 
   SolverRecommendsOptionSet _recommendsSolverOpts { *this };
   SolverInstallsOptionSet _installsSolverOpts { *this };
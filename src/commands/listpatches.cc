@@ -46,18 +46,23 @@ int ListPatchesCmd::execute( Zypper &zypper, const std::vector<std::string> &pos
       return ( ZYPPER_EXIT_ERR_INVALID_ARGS );
     }
 
-    int code = defaultSystemSetup( zypper, InitTarget | InitRepos | LoadResolvables | Resolve );
+    int code = defaultSystemSetup( zypper, InitTarget | InitRepos );
     if ( code != ZYPPER_EXIT_OK )
       return code;
 
-    ResKindSet kinds {
-      ResKind::patch
-    };
+    cached_update_query( zypper, [&]() {
+      if ( defaultSystemSetup( zypper, LoadResolvables | Resolve ) != ZYPPER_EXIT_OK )
+        return;
 
-    if ( _selectPatchOpts._select._requestedIssues.size() )
-      list_patches_by_issue( zypper, _all, _selectPatchOpts._select );
-    else
-      list_updates( zypper, kinds, false, _all, _selectPatchOpts._select );
+      ResKindSet kinds {
+        ResKind::patch
+      };
+
+      if ( _selectPatchOpts._select._requestedIssues.size() )
+        list_patches_by_issue( zypper, _all, _selectPatchOpts._select );
+      else
+        list_updates( zypper, kinds, false, _all, _selectPatchOpts._select );
+    } );
 
     return zypper.exitCode();
 }
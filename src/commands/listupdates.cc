@@ -55,10 +55,13 @@ int ListUpdatesCmd::execute( Zypper &zypper, const std::vector<std::string> &pos
   if ( _kinds.empty() )
     _kinds.insert( ResKind::package );
 
-  int code = defaultSystemSetup( zypper, InitTarget | InitRepos | LoadResolvables | Resolve );
+  int code = defaultSystemSetup( zypper, InitTarget | InitRepos );
   if ( code != ZYPPER_EXIT_OK )
     return code;
 
-  list_updates( zypper, _kinds, _bestEffort, _all );
+  cached_update_query( zypper, [&]() {
+    if ( defaultSystemSetup( zypper, LoadResolvables | Resolve ) == ZYPPER_EXIT_OK )
+      list_updates( zypper, _kinds, _bestEffort, _all );
+  } );
   return zypper.exitCode();
 }
@@ -403,3 +403,18 @@ void SortResultOptionSet::reset()
 {
   _mode = SortMode::Default;
 }
+
+std::vector<ZyppFlags::CommandGroup> SavePlanOptionSet::options()
+{
+  return {{{
+        { "save-plan", '\0', ZyppFlags::RequiredArgument, ZyppFlags::StringType( &_file, boost::optional<const char *>(), ARG_FILE ),
+              // translators: --save-plan <FILE>
+              _("Save the solved transaction to FILE. It can be replayed by 'zypper apply-plan' on hosts with the same repositories and installed packages.")
+        }
+  }}};
+}
+
+void SavePlanOptionSet::reset()
+{
+  _file.clear();
+}
@@ -156,6 +156,26 @@ public:
   void reset() override;
 };
 
+/**
+ * --save-plan FILE: save the solved transaction for the apply-plan command
+ */
+class SavePlanOptionSet : public BaseCommandOptionSet
+{
+public:
+  using BaseCommandOptionSet::BaseCommandOptionSet;
+
+  const std::string & file() const
+  { return _file; }
+
+private:
+  std::string _file;
+
+  // BaseCommandOptionSet interface
+public:
+  std::vector<ZyppFlags::CommandGroup> options() override;
+  void reset() override;
+};
+
 class SortResultOptionSet : public BaseCommandOptionSet, public RugCompatModeMixin
 {
 public:
@@ -35,6 +35,7 @@ private:
   LicensePolicyOptionSet _licensePolicyOpts { *this };
   DryRunOptionSet _dryRunOpts { *this };
   DownloadOptionSet _downloadModeOpts { *this };
+  SavePlanOptionSet _savePlanOpts { *this };
   SolverCommonOptionSet _commonSolverOpts { *this };
   SolverRecommendsOptionSet _recommendsSolverOpts { *this };
   SolverInstallsOptionSet _installSolverOpts { *this };
@@ -51,13 +51,10 @@ int PatchCheckCmd::execute( Zypper &zypper, const std::vector<std::string> &posi
   if ( code != ZYPPER_EXIT_OK )
     return code;
 
-  // TODO calc token?
-
-  // now load resolvables:
-  code = defaultSystemSetup( zypper, LoadResolvables | Resolve );
-  if ( code != ZYPPER_EXIT_OK )
-    return code;
-
-  patch_check( _updateStackOnly );
+  // now load resolvables, unless the result is cached:
+  cached_update_query( zypper, [&]() {
+    if ( defaultSystemSetup( zypper, LoadResolvables | Resolve ) == ZYPPER_EXIT_OK )
+      patch_check( _updateStackOnly );
+  } );
   return zypper.exitCode();
 }
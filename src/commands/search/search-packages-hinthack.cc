@@ -5,7 +5,17 @@
                              |__/|_|  |_|
 \*---------------------------------------------------------------------------*/
 
+#include <sys/wait.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <thread>
+#include <fstream>
+
 #include <zypp/base/LogTools.h>
+#include <zypp/TmpPath.h>
 #include <zypp/target/rpm/librpmDb.h>
 #include <zypp/ui/Selectable.h>
 #include <zypp/ResPool.h>
@@ -120,6 +130,19 @@ namespace searchPackagesHintHack
       return bool(callSP);
     }
 
+    /** The commandline forwarding the search request to search-packages subcommand. */
+    SubcommandOptions::Arglist searchPackagesArgs( Zypper & zypper_r )
+    {
+      // Slightly adjust the commandline and forward it to the subcommand
+      SubcommandOptions::Arglist args { zypper_r.argv(), zypper_r.argv()+zypper_r.argc() };
+      args[0] = "search-packages";
+      // indicate it's called from zypper; replacing the command name it also separates global and command opts
+      args[argvCmdIdx] = "--no-query-local";
+      // explicitly insert "--" in case the plugin does not know whether the last option takes an argument
+      args.insert( args.begin()+argvArgIdx, "--" );
+      return args;
+    }
+
     /** Forward the search request to search-packages subcommand. */
     void callSearchPackages( Zypper & zypper_r )
     {
@@ -128,22 +151,109 @@ namespace searchPackagesHintHack
       plgOptions->_detected._cmd = "search-packages";
       plgOptions->_detected._name = ZSPP_BinaryPath.basename();
       plgOptions->_detected._path = ZSPP_BinaryPath.dirname();
-      // Slightly adjust the commandline and forward it to the subcommand
-      {
-	SubcommandOptions::Arglist args { zypper_r.argv(), zypper_r.argv()+zypper_r.argc() };
-	args[0] = "search-packages";
-	// indicate it's called from zypper; replacing the command name it also separates global and command opts
-	args[argvCmdIdx] = "--no-query-local";
-	// explicitly insert "--" in case the plugin does not know whether the last option takes an argument
-	args.insert( args.begin()+argvArgIdx, "--" );
-
-	plgOptions->args( std::move(args) );
-      }
+      plgOptions->args( searchPackagesArgs( zypper_r ) );
 
       SubCmd cmd ( { plgOptions->_detected._cmd }, plgOptions );
       cmd.runCmd( zypper_r );
     }
 
+    ///////////////////////////////////////////////////////////////////
+    /// \class BackgroundSearchPackages
+    /// \brief search-packages subcommand running while the local search is done.
+    ///
+    /// stdin is redirected from /dev/null (it must not prompt), stdout and
+    /// stderr are collected in a temp file and written after the local
+    /// results. The subcommand is killed if it exceeds its \ref budget.
+    ///////////////////////////////////////////////////////////////////
+    struct BackgroundSearchPackages
+    {
+      using Clock = std::chrono::steady_clock;
+
+      /** Max. time the remote lookup may take (counted from its start). */
+      static constexpr std::chrono::seconds budget { 5 };
+
+      BackgroundSearchPackages( const SubcommandOptions::Arglist & args_r )
+      : _deadline( Clock::now() + budget )
+      {
+	std::vector<const char *> argv;
+	std::string arg0 { ZSPP_BinaryPath.asString() };
+	argv.push_back( arg0.c_str() );
+	for ( auto it = args_r.begin()+1; it != args_r.end(); ++it )
+	  argv.push_back( it->c_str() );
+	argv.push_back( nullptr );
+
+	DBG << "Starting in background: " << args_r << endl;
+	fflush(nullptr);
+	_pid = fork();
+	if ( _pid == 0 )
+	{
+	  int in = ::open( "/dev/null", O_RDONLY );
+	  int out = ::open( _output.path().c_str(), O_WRONLY|O_TRUNC );
+	  if ( in < 0 || out < 0 || dup2( in, STDIN_FILENO ) < 0 || dup2( out, STDOUT_FILENO ) < 0 || dup2( out, STDERR_FILENO ) < 0 )
+	    _exit( 128 );
+	  for ( int i = ::getdtablesize() - 1; i > STDERR_FILENO; --i )
+	    fcntl( i, F_SETFD, FD_CLOEXEC, true );
+
+	  execv( argv[0], (char**)argv.data() );
+	  _exit( 128 );
+	}
+	else if ( _pid < 0 )
+	  ERR << "fork for " << arg0 << " failed (" << strerror(errno) << ")" << endl;
+      }
+
+      ~BackgroundSearchPackages()
+      {
+	if ( _pid > 0 )
+	{
+	  ::kill( _pid, SIGTERM );
+	  reap( 0 );
+	}
+      }
+
+      /** Wait until the subcommand exited or the budget is exhausted. Return whether it completed. */
+      bool wait()
+      {
+	while ( _pid > 0 )
+	{
+	  if ( reap( WNOHANG ) )
+	    return true;
+	  if ( Clock::now() >= _deadline )
+	    return false;
+	  std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+	}
+	return _pid == 0;
+      }
+
+      /** Write the collected output. */
+      void writeOutput( std::ostream & str_r ) const
+      {
+	std::ifstream in( _output.path().c_str() );
+	if ( in && in.peek() != std::ifstream::traits_type::eof() )
+	  str_r << in.rdbuf() << std::flush;
+      }
+
+    private:
+      bool reap( int options_r )
+      {
+	int status = 0;
+	pid_t ret;
+	while ( (ret = waitpid( _pid, &status, options_r )) < 0 && errno == EINTR )
+	{;}
+	if ( ret == 0 )
+	  return false;	// still running
+	_pid = 0;
+	return true;
+      }
+
+      filesystem::TmpFile _output;
+      Clock::time_point _deadline;
+      pid_t _pid = -1;	///< -1 not started, 0 exited
+    };
+    constexpr std::chrono::seconds BackgroundSearchPackages::budget;
+
+    /** The search-packages started by \ref prefetch */
+    std::unique_ptr<BackgroundSearchPackages> backgroundRun;
+
 
   } // namespace
   ///////////////////////////////////////////////////////////////////
@@ -153,8 +263,39 @@ namespace searchPackagesHintHack
   int argvCmdIdx = 0;
   int argvArgIdx = 0;
 
+  void prefetch( Zypper & zypper_r )
+  {
+    backgroundRun.reset();
+    if ( ! maySearchPackagesAtAll( zypper_r ) || zypper_r.runningHelp() )
+      return;
+
+    // Without the users consent (runSearchPackages = always) we do not query remote resources.
+    if ( ! bool( zypper_r.config().search_runSearchPackages ) )
+      return;
+
+    if ( ! PathInfo( ZSPP_BinaryPath ).isFile() || ! searchPackagesSupportsZypperCliForwarding() )
+      return;
+
+    backgroundRun.reset( new BackgroundSearchPackages( searchPackagesArgs( zypper_r ) ) );
+  }
+
   void callOrNotify( Zypper & zypper_r )
   {
+    if ( backgroundRun )
+    {
+      std::unique_ptr<BackgroundSearchPackages> run { std::move(backgroundRun) };
+      userDecissionToCallSearchPackages( zypper_r );	// prints the 'Enabled in zypper.conf' hint
+      if ( run->wait() )
+	run->writeOutput( cout );
+      else
+      {
+	run.reset();	// kills it
+	// translator: %1% denotes a zypper command to execute. Like 'zypper search-packages'.
+	zypper_r.out().warning( str::Format(_("Searching in not yet activated remote resources timed out. You can run '%1%' at any time.")) % "zypper search-packages" );
+      }
+      return;
+    }
+
     if ( ! maySearchPackagesAtAll( zypper_r ) )
       return;
 
@@ -20,6 +20,14 @@ namespace searchPackagesHintHack
    */
   void callOrNotify( Zypper & zypper_r );
 
+  /** Start the \c search-packages subcommand in the background, if it is going to be called anyway.
+   * This is the case if \c runSearchPackages is set to \c always in zypper.conf. The subcommand
+   * then runs while the local search is done. Its output is collected and printed by \ref callOrNotify
+   * after the local results, unless it exceeds its latency budget. In this case it is killed and a
+   * hint is printed instead.
+   */
+  void prefetch( Zypper & zypper_r );
+
 } // searchPackagesHintHack
 ///////////////////////////////////////////////////////////////////
 #endif // ZYPPER_COMMANDS_SEARCH_SEARCH_PACKAGES_HINTHACK_H_INCLUDED
@@ -5,12 +5,14 @@
 #include "commands/commonflags.h"
 #include "commands/commandhelpformatter.h"
 #include "commands/search/search-packages-hinthack.h"
+#include "utils/MultiPatternQuery.h"
 
 #include <zypp/base/Algorithm.h>
 #include <zypp/sat/Solvable.h>
 #include <zypp/Capability.h>
 #include <zypp/PoolQueryResult.h>
 
+#include <optional>
 #include <unordered_map>
 
 namespace zypp
@@ -50,6 +52,9 @@ namespace
     }
     return false;
   }
+
+  /** From this number of plain search strings on, matching is done in a single pool pass. */
+  constexpr unsigned multiPatternThreshold = 8;
 }
 
 
@@ -271,6 +276,10 @@ int SearchCmd::execute( Zypper &zypper, const std::vector<std::string> &position
       query.addKind( knd );
   }
 
+  // a remote search-packages lookup (if enabled) runs while we search locally
+  if ( !_requestedReverseSearch.is_initialized() )
+    searchPackagesHintHack::prefetch( zypper );
+
   // load system data...
   int code = defaultSystemSetup(  zypper, InitTarget | InitRepos | LoadResolvables | Resolve  );
   if ( code != ZYPPER_EXIT_OK )
@@ -297,6 +306,30 @@ int SearchCmd::execute( Zypper &zypper, const std::vector<std::string> &position
     _requestedDeps.insert( sat::SolvAttr::name );
 
   bool details = _details || _verbose;
+
+  // Many plain search strings in names (and descriptions) are matched in a single pass.
+  bool multiPattern = positionalArgs_r.size() >= multiPatternThreshold
+                   && _mode != MatchMode::Words && !_verbose && !_requestedReverseSearch
+                   && _requestedDeps.size() == 1 && *_requestedDeps.begin() == sat::SolvAttr::name;
+  MultiPatternQuery multiQuery( _mode == MatchMode::Exact ? MultiPatternMatcher::Mode::Exact : MultiPatternMatcher::Mode::Substring,
+                                _caseSensitive );
+  multiQuery._searchDesc = _searchDesc;
+  // PoolQuery does no COW :( - build the basic query (kinds, repos and
+  // installed filter but no search strings) on its own.
+  PoolQuery baseQuery;
+  if ( multiPattern )
+  {
+    if ( inst_notinst == false )
+      baseQuery.setUninstalledOnly();
+    for ( const ResKind &knd : _requestedTypes )
+      baseQuery.addKind( knd );
+    if ( InitRepoSettings::instance()._repoFilter.size() )
+    {
+      for ( const RepoInfo & repo : zypper.runtimeData().repos )
+        baseQuery.addRepo( repo.alias() );
+    }
+  }
+
   // add argument strings and attributes to query
   for_( it, positionalArgs_r.begin(), positionalArgs_r.end() )
   {
@@ -328,6 +361,15 @@ int SearchCmd::execute( Zypper &zypper, const std::vector<std::string> &position
     }
     // else: match mode explicitly requested by cli arg
 
+    if ( multiPattern )
+    {
+      if ( matchmode == Match::OTHER && explicitBuildin == ResKind::nokind
+           && cap.detail().isNamed() && cap.detail().arch().empty() )
+        multiQuery._matcher.add( name );
+      else
+        multiPattern = false;
+    }
+
     // NOTE: We use the  addDependency  overload taking a  matchmode  argument for ALL
     // kinds of attributes, not only for dependencies. A constraint on 'op version'
     // will automatically be applied to match a matching dependency or to match
@@ -364,6 +406,8 @@ int SearchCmd::execute( Zypper &zypper, const std::vector<std::string> &position
             query.addDependency( sat::SolvAttr::name, n, Rel::EQ, e, Arch(cap.detail().arch()), Match::STRING );
             if ( poolExpectMatchFor( n, e ) )
               details = true;	// show details if any search string includes an edition
+            if ( multiPattern )
+              multiQuery.addEdition( n, e );
 
             std::string::size_type pos2 = name.find_last_of( "-", pos-1 );
             if ( pos2 != std::string::npos && pos2 != 0 &&  pos2 != pos-1)
@@ -373,6 +417,8 @@ int SearchCmd::execute( Zypper &zypper, const std::vector<std::string> &position
               query.addDependency( sat::SolvAttr::name, n, Rel::EQ, e, Arch(cap.detail().arch()), Match::STRING );
               if ( poolExpectMatchFor( n, e ) )
                 details = true;	// show details if any search string includes an edition
+              if ( multiPattern )
+                multiQuery.addEdition( n, e );
             }
           }
         }
@@ -386,9 +432,37 @@ int SearchCmd::execute( Zypper &zypper, const std::vector<std::string> &position
     }
   }
 
+  PoolQueryResult multiResult;
+  if ( multiPattern )
+    MIL << "Matching " << multiQuery._matcher.size() << " search strings in a single pass." << endl;
+
   Table t;
   try
   {
+    // In XML mode the rows are written directly, without building a Table.
+    // They are sorted like the Table would be.
+    std::optional<XmlSearchResult> xml;
+    if ( zypper.out().typeXML() )
+    {
+      XmlSearchResult::SortOrder order = XmlSearchResult::ByName;
+      if ( _details )
+	order = ( _sortOpts._mode == SortResultOptionSet::ByRepo ? XmlSearchResult::ByRepo : XmlSearchResult::ByNameVersion );
+      xml.emplace( cout, order );
+    }
+    auto solvableCallback = [&]() {
+      return xml ? FillSearchTableSolvable( *xml, inst_notinst ) : FillSearchTableSolvable( t, inst_notinst );
+    };
+    auto selectableCallback = [&]() {
+      return xml ? FillSearchTableSelectable( *xml, inst_notinst ) : FillSearchTableSelectable( t, inst_notinst );
+    };
+
+    if ( multiPattern )
+    {
+      for ( const auto slv : baseQuery )
+        if ( multiQuery( slv ) )
+          multiResult += slv;
+    }
+
     if ( _requestedReverseSearch.is_initialized() ) {
 
       std::unordered_map< sat::Solvable, CapabilitySet > matchedSolvables;
@@ -417,7 +491,7 @@ int SearchCmd::execute( Zypper &zypper, const std::vector<std::string> &position
       }
 
       if ( details ) {
-        FillSearchTableSolvable callback( t, inst_notinst );
+        FillSearchTableSolvable callback { solvableCallback() };
         std::for_each( matchedSolvables.begin(), matchedSolvables.end(), [&callback, verb = _verbose, &reqSearchAttrib ]( auto elem ){
           if ( verb )
             callback( elem.first, reqSearchAttrib, elem.second );
@@ -429,14 +503,14 @@ int SearchCmd::execute( Zypper &zypper, const std::vector<std::string> &position
         PoolQueryResult res;
         std::for_each( matchedSolvables.begin(), matchedSolvables.end(), [ &res ]( const auto &v ){ res+=v.first; } );
 
-        FillSearchTableSelectable callback( t, inst_notinst );
+        FillSearchTableSelectable callback { selectableCallback() };
         std::for_each( res.selectableBegin(), res.selectableEnd(), callback);
       }
 
     } else {
       if ( details )
       {
-        FillSearchTableSolvable callback( t, inst_notinst );
+        FillSearchTableSolvable callback { solvableCallback() };
         if ( _verbose )
         {
           // Option 'verbose' shows where (e.g. in 'requires', 'name') the search has matched.
@@ -444,6 +518,11 @@ int SearchCmd::execute( Zypper &zypper, const std::vector<std::string> &position
           for_( it, query.begin(), query.end() )
             callback( it );
         }
+        else if ( multiPattern )
+        {
+          for ( const auto slv : multiResult )
+            callback( slv );
+        }
         else
         {
           for ( const auto slv : query )
@@ -452,16 +531,44 @@ int SearchCmd::execute( Zypper &zypper, const std::vector<std::string> &position
       }
       else
       {
-        FillSearchTableSelectable callback( t, inst_notinst );
-        invokeOnEach( query.selectableBegin(), query.selectableEnd(), callback );
+        FillSearchTableSelectable callback { selectableCallback() };
+        if ( multiPattern )
+          invokeOnEach( multiResult.selectableBegin(), multiResult.selectableEnd(), callback );
+        else
+          invokeOnEach( query.selectableBegin(), query.selectableEnd(), callback );
       }
     }
 
-    if ( t.empty() )
+    if ( xml ? xml->empty() : t.empty() )
     {
       // translators: empty search result message
       zypper.out().info(_("No matching items found."), Out::QUIET );
       zypper.setExitCode( ZYPPER_EXIT_INF_CAP_NOT_FOUND );
+
+      // typo hint for plain search strings
+      if ( _mode != MatchMode::Words && !_requestedReverseSearch.is_initialized() )
+      {
+        const ResKind & kind { _requestedTypes.size() == 1 ? *_requestedTypes.begin() : ResKind::package };
+        std::string hint;
+        for ( const std::string & arg : positionalArgs_r )
+        {
+          if ( arg.find_first_of( "?*/:<=> " ) != std::string::npos )
+            continue;
+          std::string names { similarNamesHint( arg, kind ) };
+          if ( names.empty() )
+            continue;
+          if ( ! hint.empty() )
+            hint += ", ";
+          hint += names;
+        }
+        if ( ! hint.empty() )
+          // translators: %1% expands to a single package name or a ','-separated enumeration of names.
+          zypper.out().info( str::Format(_("Did you mean %1%?")) % hint );
+      }
+    }
+    else if ( xml )
+    {
+      xml->finish();
     }
     else
     {
@@ -285,6 +285,7 @@ namespace	// command execution
     _execError.clear();
 
 
+    Out::flush();
     fflush(nullptr);
     pid_t pid = fork();
     if ( pid == 0 )
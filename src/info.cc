@@ -6,6 +6,8 @@
 \*---------------------------------------------------------------------------*/
 
 #include <iostream>
+#include <algorithm>
+#include <unordered_map>
 
 #include <zypp/base/Algorithm.h>
 #include <zypp/ZYpp.h>
@@ -14,6 +16,7 @@
 #include <zypp/Pattern.h>
 #include <zypp/Product.h>
 #include <zypp/PoolQuery.h>
+#include <zypp/sat/Pool.h>
 
 #include "Zypper.h"
 #include "main.h"
@@ -161,12 +164,9 @@ namespace {
     return baseQ;
   }
 
-  void logOtherKindMatches( const PoolQuery & q_r, const std::string & name_r )
+  void logOtherKindMatches( const std::map<ResKind,DefaultIntegral<unsigned,0U>> & count_r, const std::string & name_r )
   {
-    std::map<ResKind,DefaultIntegral<unsigned,0U>> count;
-    for_( it, q_r.selectableBegin(), q_r.selectableEnd() )
-    { ++count[(*it)->kind()]; }
-    for ( const auto & pair : count )
+    for ( const auto & pair : count_r )
     {
       cout << str::Format(PL_("There would be %1% match for '%2%'."
 			     ,"There would be %1% matches for '%2%'."
@@ -176,6 +176,119 @@ namespace {
 	   << endl;
     }
   }
+
+  void logOtherKindMatches( const PoolQuery & q_r, const std::string & name_r )
+  {
+    std::map<ResKind,DefaultIntegral<unsigned,0U>> count;
+    for_( it, q_r.selectableBegin(), q_r.selectableEnd() )
+    { ++count[(*it)->kind()]; }
+    logOtherKindMatches( count, name_r );
+  }
+
+  ///////////////////////////////////////////////////////////////////
+  /// \class InfoNameIndex
+  /// \brief Selectables of all plain names requested, collected in a single pool pass.
+  ///
+  /// Instead of running a PoolQuery per name (and a fallback query per miss),
+  /// all requested names without glob chars are looked up at once. Like the
+  /// PoolQuery, names match case-insensitive and a repo filter is applied.
+  /// The Selectables per name are remembered in pool order, which is the order
+  /// the PoolQuery would have delivered them.
+  ///////////////////////////////////////////////////////////////////
+  struct InfoNameIndex
+  {
+    InfoNameIndex( Zypper & zypper, const std::vector<std::string> & names_r )
+    {
+      for ( const std::string & rawarg : names_r )
+      {
+	KNSplit kn( rawarg );
+	if ( isPlain( kn._name ) )
+	  _index[str::toLower( kn._name )];
+      }
+      if ( _index.empty() )
+	return;
+
+      std::set<std::string> repos;
+      if ( InitRepoSettings::instance()._repoFilter.size() )
+      {
+	for ( const RepoInfo & repo : zypper.runtimeData().repos  )
+	{ repos.insert( repo.alias() ); }
+      }
+
+      for ( const sat::Solvable & solv : sat::Pool::instance().solvables() )
+      {
+	auto it = _index.find( str::toLower( solv.name() ) );
+	if ( it == _index.end() )
+	  continue;
+	if ( ! repos.empty() && ! repos.count( solv.repository().alias() ) )
+	  continue;
+
+	ui::Selectable::Ptr sel { ui::Selectable::get( solv ) };
+	if ( sel && std::find( it->second.begin(), it->second.end(), sel ) == it->second.end() )
+	  it->second.push_back( sel );
+      }
+      MIL << "Looked up " << _index.size() << " names in a single pool pass." << endl;
+    }
+
+    static bool isPlain( const std::string & name_r )
+    { return name_r.find_first_of( "*?[" ) == std::string::npos; }
+
+    /** Whether \a name_r was looked up. */
+    bool covers( const std::string & name_r ) const
+    { return isPlain( name_r ) && _index.count( str::toLower( name_r ) ); }
+
+    /** The Selectables named \a name_r of the \a kinds_r (any if empty). */
+    std::vector<ui::Selectable::Ptr> lookup( const std::string & name_r, const std::set<ResKind> & kinds_r ) const
+    {
+      std::vector<ui::Selectable::Ptr> ret;
+      auto it = _index.find( str::toLower( name_r ) );
+      if ( it != _index.end() )
+      {
+	for ( const ui::Selectable::Ptr & sel : it->second )
+	  if ( kinds_r.empty() || kinds_r.count( sel->kind() ) )
+	    ret.push_back( sel );
+      }
+      return ret;
+    }
+
+  private:
+    std::unordered_map<std::string, std::vector<ui::Selectable::Ptr>> _index;
+  };
+
+  void printSelectableInfo( Zypper & zypper, const ui::Selectable & sel, const PrintInfoOptions &options_r )
+  {
+    if ( zypper.out().type() != Out::TYPE_XML )
+    {
+      // TranslatorExplanation E.g. "Information for package zypper:"
+      std::string info = str::Format(_("Information for %s %s:"))
+			       % kind_to_string_localized( sel.kind(), 1 )
+			       % sel.name();
+
+      cout << endl << info << endl;
+      cout << std::string( mbs_width(info), '-' ) << endl;
+    }
+
+    if      ( sel.kind() == ResKind::package )	{ printPkgInfo( zypper, sel, options_r ); }
+    else if ( sel.kind() == ResKind::patch )		{ printPatchInfo( zypper, sel, options_r ); }
+    else if ( sel.kind() == ResKind::pattern )	{ printPatternInfo( zypper, sel, options_r ); }
+    else if ( sel.kind() == ResKind::product )	{ printProductInfo( zypper, sel, options_r ); }
+    else if ( sel.kind() == ResKind::srcpackage)	{ printSrcPackageInfo( zypper, sel, options_r ); }
+    else 						{ printDefaultInfo( zypper, sel, options_r ); }
+  }
+
+  void printNotFound( const KNSplit & kn_r, const std::string & rawarg_r, const PrintInfoOptions &options_r )
+  {
+    ResKind oneKind( kn_r._kind );
+    if ( !oneKind )
+    {
+      if ( !options_r._kinds.empty() && options_r._kinds.size() == 1 )
+	oneKind = *options_r._kinds.begin();
+      else
+	oneKind = ResKind::package;
+    }
+    // TranslatorExplanation E.g. "package 'zypper' not found."
+    cout << "\n" << str::Format(_("%s '%s' not found.")) % kind_to_string_localized( oneKind, 1 ) % rawarg_r << endl;
+  }
 } // namespace
 ///////////////////////////////////////////////////////////////////
 
@@ -183,42 +296,66 @@ void printInfo(Zypper & zypper, const std::vector<std::string> &names_r, const P
 {
   zypper.out().gap();
 
+  // Many plain names are resolved in a single pool pass (glob and substring matches need the PoolQuery)
+  std::unique_ptr<InfoNameIndex> index;
+  if ( names_r.size() > 1 && ! options_r._matchSubstrings )
+    index.reset( new InfoNameIndex( zypper, names_r ) );
+
   for ( const std::string & rawarg : names_r )
   {
     // Use the right kind!
     KNSplit kn( rawarg );
 
-    PoolQuery q( printInfo_BasicQuery( zypper, options_r ) );
-    q.addAttribute( sat::SolvAttr::name, kn._name );
-
+    std::set<ResKind> kinds;
     bool fallBackToAny = false;
     if ( kn._kind )
     {
-      q.addKind( kn._kind );			// explicit kind in arg
+      kinds.insert( kn._kind );			// explicit kind in arg
     }
     else if ( !options_r._kinds.empty() )
     {
-      for ( const auto & kind : options_r._kinds )	// wanted kinds via -t
-	q.addKind( kind );
+      kinds = options_r._kinds;			// wanted kinds via -t
     }
     else
     {
-      q.addKind( ResKind::package );
+      kinds.insert( ResKind::package );
       fallBackToAny = true;			// Prefer packages, but fall back to any
     }
 
-    if ( q.empty() )
+    if ( index && index->covers( kn._name ) )
     {
-      ResKind oneKind( kn._kind );
-      if ( !oneKind )
+      std::vector<ui::Selectable::Ptr> sels { index->lookup( kn._name, kinds ) };
+      if ( sels.empty() )
       {
-	if ( !options_r._kinds.empty() && options_r._kinds.size() == 1 )
-	  oneKind = *options_r._kinds.begin();
-	else
-	  oneKind = ResKind::package;
+	printNotFound( kn, rawarg, options_r );
+
+	// hint to matches of different kind (preferPackages looked for any)
+	sels = index->lookup( kn._name, {} );
+	if ( sels.empty() )
+	  continue;
+	else if ( !fallBackToAny )
+	{
+	  std::map<ResKind,DefaultIntegral<unsigned,0U>> count;
+	  for ( const ui::Selectable::Ptr & sel : sels )
+	  { ++count[sel->kind()]; }
+	  logOtherKindMatches( count, kn._name );
+	  continue;
+	}
       }
-      // TranslatorExplanation E.g. "package 'zypper' not found."
-      cout << "\n" << str::Format(_("%s '%s' not found.")) % kind_to_string_localized( oneKind, 1 ) % rawarg << endl;
+
+      for ( const ui::Selectable::Ptr & sel : sels )
+	printSelectableInfo( zypper, *sel, options_r );
+      continue;
+    }
+
+    PoolQuery q( printInfo_BasicQuery( zypper, options_r ) );
+    q.addAttribute( sat::SolvAttr::name, kn._name );
+    for ( const auto & kind : kinds )
+      q.addKind( kind );
+
+    if ( q.empty() )
+    {
+      printNotFound( kn, rawarg, options_r );
 
       // hint to matches of different kind (preferPackages looked for any)
       PoolQuery h( printInfo_BasicQuery( zypper, options_r ) );
@@ -236,27 +373,7 @@ void printInfo(Zypper & zypper, const std::vector<std::string> &names_r, const P
     }
 
     for_( it, q.selectableBegin(), q.selectableEnd() )
-    {
-      const ui::Selectable & sel( *(*it) );
-
-      if ( zypper.out().type() != Out::TYPE_XML )
-      {
-	// TranslatorExplanation E.g. "Information for package zypper:"
-	std::string info = str::Format(_("Information for %s %s:"))
-				 % kind_to_string_localized( sel.kind(), 1 )
-				 % sel.name();
-
-	cout << endl << info << endl;
-	cout << std::string( mbs_width(info), '-' ) << endl;
-      }
-
-      if      ( sel.kind() == ResKind::package )	{ printPkgInfo( zypper, sel, options_r ); }
-      else if ( sel.kind() == ResKind::patch )		{ printPatchInfo( zypper, sel, options_r ); }
-      else if ( sel.kind() == ResKind::pattern )	{ printPatternInfo( zypper, sel, options_r ); }
-      else if ( sel.kind() == ResKind::product )	{ printProductInfo( zypper, sel, options_r ); }
-      else if ( sel.kind() == ResKind::srcpackage)	{ printSrcPackageInfo( zypper, sel, options_r ); }
-      else 						{ printDefaultInfo( zypper, sel, options_r ); }
-    }
+      printSelectableInfo( zypper, *(*it), options_r );
   }
 }
 
@@ -450,25 +567,25 @@ void printPatternInfo(Zypper & zypper, const ui::Selectable & s , const PrintInf
       for ( ui::Selectable::Ptr sel : collect.req.selectable() )
       {
 	const ui::Selectable & s = *sel;
-	t << ( TableRow() << computeStatusIndicator( s ) << s.name() << s.kind().asString() << _("Required") );
+	t << ( TableRow() << cachedStatusIndicator( s ) << s.name() << s.kind().asString() << _("Required") );
       }
       for ( ui::Selectable::Ptr sel : collect.rec.selectable() )
       {
 	const ui::Selectable & s = *sel;
-	t << ( TableRow() << computeStatusIndicator( s ) << s.name() << s.kind().asString() << _("Recommended") );
+	t << ( TableRow() << cachedStatusIndicator( s ) << s.name() << s.kind().asString() << _("Recommended") );
       }
       if ( showSuggests )
 	for ( ui::Selectable::Ptr sel : collect.sug.selectable() )
 	{
 	  const ui::Selectable & s = *sel;
-	  t << ( TableRow() << computeStatusIndicator( s ) << s.name() << s.kind().asString() << _("Suggested") );
+	  t << ( TableRow() << cachedStatusIndicator( s ) << s.name() << s.kind().asString() << _("Suggested") );
 	}
 
       std::map<std::string, unsigned> depPrio({{_("Required"),0}, {_("Recommended"),1}, {_("Suggested"),2}});
-      t.sort( [&depPrio]( const TableRow & lhs, const TableRow & rhs ) -> bool {
-	if ( lhs.columns()[3] != rhs.columns()[3] )
-	  return depPrio[lhs.columns()[3]] < depPrio[rhs.columns()[3]];
-	return  lhs.columns()[1] < rhs.columns()[1];
+      t.sort( [&depPrio]( const Table::RowRef & lhs, const Table::RowRef & rhs ) -> bool {
+	if ( lhs[3] != rhs[3] )
+	  return depPrio[lhs[3].to_string()] < depPrio[rhs[3].to_string()];
+	return  lhs[1] < rhs[1];
       } );
 
       // translators: property name; short; used like "Name: value"
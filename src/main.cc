@@ -99,6 +99,10 @@ int main( int argc, char **argv )
     }
   } say_goodbye __attribute__ ((__unused__));
 
+  // Unless writing to a terminal, don't flush (write) each line; set up
+  // before anything (like Zypper::instance) may write at exit.
+  Out::bufferStdout();
+
   // bsc#1183589: Protect against strict/relaxed user umask via sudo
   bool sudo = false;	// will be mentioned in the log
   if ( geteuid() == 0 ) {
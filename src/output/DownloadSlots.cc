@@ -0,0 +1,72 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+#include <algorithm>
+
+#include "DownloadSlots.h"
+
+namespace out
+{
+  std::vector<DownloadSlots::Slot>::iterator DownloadSlots::find( const std::string & key_r )
+  {
+    return std::find_if( _slots.begin(), _slots.end(), [&key_r]( const Slot & slot_r ) {
+      return slot_r._key == key_r;
+    } );
+  }
+
+  void DownloadSlots::start( const std::string & key_r, const std::string & label_r, Clock::time_point now_r )
+  {
+    auto it = find( key_r );
+    if ( it == _slots.end() )
+      it = _slots.insert( _slots.end(), Slot() );
+    it->_key = key_r;
+    it->_label = label_r;
+    it->_percent = -1;
+    it->_rate = -1;
+    it->_started = now_r;
+  }
+
+  bool DownloadSlots::update( const std::string & key_r, int percent_r, long rate_r )
+  {
+    auto it = find( key_r );
+    if ( it == _slots.end() )
+      return false;
+    it->_percent = percent_r;
+    it->_rate = rate_r;
+    return true;
+  }
+
+  void DownloadSlots::finish( const std::string & key_r )
+  {
+    auto it = find( key_r );
+    if ( it != _slots.end() )
+      _slots.erase( it );
+  }
+
+  long DownloadSlots::totalRate() const
+  {
+    long ret = -1;
+    for ( const Slot & slot : _slots )
+    {
+      if ( slot._rate > 0 )
+	ret = ( ret < 0 ? 0 : ret ) + slot._rate;
+    }
+    return ret;
+  }
+
+  long DownloadSlots::eta( Clock::time_point now_r ) const
+  {
+    long ret = -1;
+    for ( const Slot & slot : _slots )
+    {
+      if ( slot._percent <= 0 || slot._percent > 100 )
+	continue;
+      long elapsed = std::chrono::duration_cast<std::chrono::seconds>( now_r - slot._started ).count();
+      ret = std::max( ret, elapsed * ( 100 - slot._percent ) / slot._percent );
+    }
+    return ret;
+  }
+} // namespace out
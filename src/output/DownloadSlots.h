@@ -0,0 +1,75 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+#ifndef ZYPPER_OUTPUT_DOWNLOADSLOTS_H
+#define ZYPPER_OUTPUT_DOWNLOADSLOTS_H
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace out
+{
+  ///////////////////////////////////////////////////////////////////
+  /// \class DownloadSlots
+  /// \brief The active downloads shown in the download progress view.
+  ///
+  /// One \ref Slot per download that has started and not yet finished. The
+  /// slots stay in start order. Besides the per-download values this
+  /// computes the aggregate throughput and an ETA for the whole set.
+  ///
+  /// \note Not thread safe on its own; the owner (\ref OutNormal) guards
+  /// it together with the terminal output.
+  ///////////////////////////////////////////////////////////////////
+  class DownloadSlots
+  {
+  public:
+    typedef std::chrono::steady_clock Clock;
+
+    struct Slot
+    {
+      std::string _key;		///< identifies the download (the Url)
+      std::string _label;	///< shown in the progress line
+      int _percent = -1;	///< -1 if unknown
+      long _rate = -1;		///< current rate in B/s, -1 if unknown
+      Clock::time_point _started;
+    };
+
+    /** Add a download (or restart it if \a key_r is already active). */
+    void start( const std::string & key_r, const std::string & label_r, Clock::time_point now_r = Clock::now() );
+
+    /** Update a download; returns \c false if \a key_r is not active. */
+    bool update( const std::string & key_r, int percent_r, long rate_r );
+
+    /** Remove a download. */
+    void finish( const std::string & key_r );
+
+    bool empty() const
+    { return _slots.empty(); }
+
+    unsigned size() const
+    { return _slots.size(); }
+
+    /** The active downloads in start order. */
+    const std::vector<Slot> & slots() const
+    { return _slots; }
+
+    /** Sum of the known current rates in B/s, -1 if none is known. */
+    long totalRate() const;
+
+    /** Estimated seconds until the last active download is done, -1 if unknown.
+     * Each download is extrapolated from its elapsed time and percentage.
+     */
+    long eta( Clock::time_point now_r = Clock::now() ) const;
+
+  private:
+    std::vector<Slot>::iterator find( const std::string & key_r );
+
+    std::vector<Slot> _slots;	///< usually just a few, so no map
+  };
+} // namespace out
+
+#endif // ZYPPER_OUTPUT_DOWNLOADSLOTS_H
@@ -1,7 +1,9 @@
 #include <unistd.h>
 
+#include <cstring>
 #include <iostream>
 #include <sstream>
+#include <vector>
 
 //#include <zypp/AutoDispose.h>
 
@@ -96,6 +98,95 @@ std::string TermLine::get( unsigned width_r, SplitFlags flags_r, char exp_r ) co
 constexpr Out::Type Out::TYPE_NONE;
 constexpr Out::Type Out::TYPE_ALL;
 
+namespace
+{
+  class DeferredFlushBuf;
+  DeferredFlushBuf * deferredFlushBuf = nullptr;	///< if installed by Out::bufferStdout
+
+  ///////////////////////////////////////////////////////////////////
+  /// \class DeferredFlushBuf
+  /// \brief std::cout streambuf writing to the original one in big chunks.
+  ///
+  /// \c sync (std::endl, std::flush) is a noop; \ref flushNow writes.
+  class DeferredFlushBuf : public std::streambuf
+  {
+  public:
+    DeferredFlushBuf()
+    : _buf( 64 * 1024 )
+    {
+      setp( _buf.data(), _buf.data() + _buf.size() );
+      _target = std::cout.rdbuf( this );
+    }
+
+    ~DeferredFlushBuf()
+    {
+      flushNow();
+      std::cout.rdbuf( _target );
+      if ( deferredFlushBuf == this )
+	deferredFlushBuf = nullptr;
+    }
+
+    void flushNow()
+    {
+      writeOut();
+      _target->pubsync();
+    }
+
+  protected:
+    int_type overflow( int_type ch ) override
+    {
+      writeOut();
+      if ( ! traits_type::eq_int_type( ch, traits_type::eof() ) )
+	sputc( traits_type::to_char_type( ch ) );
+      return traits_type::not_eof( ch );
+    }
+
+    std::streamsize xsputn( const char * s, std::streamsize n ) override
+    {
+      if ( n > epptr() - pptr() )
+      {
+	writeOut();
+	if ( n >= epptr() - pptr() )
+	  return _target->sputn( s, n );	// don't copy big chunks
+      }
+      ::memcpy( pptr(), s, n );
+      pbump( n );
+      return n;
+    }
+
+    int sync() override
+    { return 0; }
+
+  private:
+    void writeOut()
+    {
+      if ( pptr() != pbase() )
+      {
+	_target->sputn( pbase(), pptr() - pbase() );
+	setp( _buf.data(), _buf.data() + _buf.size() );
+      }
+    }
+
+    std::vector<char> _buf;
+    std::streambuf * _target;
+  };
+} // namespace
+
+void Out::bufferStdout()
+{
+  if ( deferredFlushBuf || ::isatty( STDOUT_FILENO ) )
+    return;	// a terminal wants to see each line
+  static DeferredFlushBuf buf;	// flushed at exit
+  deferredFlushBuf = &buf;
+}
+
+void Out::flush()
+{
+  std::cout.flush();	// e.g. OutJSON
+  if ( deferredFlushBuf )
+    deferredFlushBuf->flushNow();
+}
+
 Out::~Out()
 {}
 
@@ -552,6 +552,16 @@ public:
 	      const TContainer & container_r, const TFormater & formater_r = TFormater() )
   { container( nodeName_r, title_r, container_r, formater_r ); }
 
+public:
+  /** Unless stdout is a terminal, collect std::cout output in a big buffer.
+   * \c std::endl and \c std::flush no longer write each line; pending
+   * output is written if the buffer is full, at \ref flush and at exit.
+   */
+  static void bufferStdout();
+
+  /** Write pending std::cout output (prompts, progress redraws, ...). */
+  static void flush();
+
 public:
   /** NORMAL: An empty line */
   void gap() { if ( type() == TYPE_NORMAL ) std::cout << std::endl; }
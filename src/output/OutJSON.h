@@ -0,0 +1,50 @@
+#ifndef OUTJSON_H_
+#define OUTJSON_H_
+
+#include <iostream>
+
+#include "OutXML.h"
+#include "utils/XmlToJsonLines.h"
+
+namespace out
+{
+  ///////////////////////////////////////////////////////////////////
+  /// \class CoutAsJsonLines
+  /// \brief Translate everything written to std::cout into JSON Lines while alive.
+  struct CoutAsJsonLines
+  {
+    CoutAsJsonLines()
+    : _json( std::cout.rdbuf() )
+    { _orig = std::cout.rdbuf( &_json ); }
+
+    ~CoutAsJsonLines()
+    {
+      std::cout.flush();
+      std::cout.rdbuf( _orig );
+    }
+
+  private:
+    XmlToJsonLines _json;
+    std::streambuf * _orig;
+  };
+} // namespace out
+
+///////////////////////////////////////////////////////////////////
+/// \class OutJSON
+/// \brief JSON Lines output (--jsonout)
+///
+/// Technically this is \ref OutXML and all the XML code paths in zypper
+/// apply. But the XML stream written to std::cout is translated into one
+/// self-contained JSON object per line by \ref XmlToJsonLines. So the
+/// JSON output covers exactly what \c xmlout.rnc covers, without the need
+/// to maintain a second writer at each call site.
+///////////////////////////////////////////////////////////////////
+class OutJSON : private out::CoutAsJsonLines, public OutXML	// CoutAsJsonLines must be constructed first
+{
+public:
+  OutJSON( Verbosity verbosity = NORMAL )
+  : OutXML( verbosity )
+  {}
+};
+
+#endif /*OUTJSON_H_*/
@@ -8,6 +8,7 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <vector>
 
 #include <unistd.h>
 
@@ -32,6 +33,8 @@ OutNormal::OutNormal( Verbosity verbosity_r )
 , _isatty( do_ttyout() )
 , _newline( true )
 , _oneup( false )
+, _progressLine( cout )
+, _dwnldLines( 0 )
 {}
 
 OutNormal::~OutNormal()
@@ -86,6 +89,7 @@ void OutNormal::error( const std::string & problem_desc, const std::string & hin
 {
   if ( !_newline )
     cout << endl;
+  flush();	// keep stdout and stderr in order
 
   cerr << ( ColorContext::MSG_ERROR << problem_desc );
   if ( !hint.empty() && verbosity() > Out::QUIET )
@@ -100,6 +104,7 @@ void OutNormal::error( const Exception & e, const std::string & problem_desc, co
 {
   if ( !_newline )
     cout << endl;
+  flush();	// keep stdout and stderr in order
 
   // problem and cause
   cerr << ( ColorContext::MSG_ERROR << problem_desc << endl << zyppExceptionReport(e) ) << endl;
@@ -113,12 +118,22 @@ void OutNormal::error( const Exception & e, const std::string & problem_desc, co
 
 // ----------------------------------------------------------------------------
 
-void OutNormal::displayProgress ( const std::string & s, int percent )
+bool OutNormal::progressLineDue()
+{
+  if ( _newline )	// something else was printed since
+    _progressLine.reset();
+  return _progressLine.due();
+}
+
+void OutNormal::displayProgress ( const std::string & s, int percent, bool force )
 {
   static AliveCursor cursor;
 
   if ( _isatty )
   {
+    if ( ! ( progressLineDue() || force ) )
+      return;
+
     TermLine outstr( TermLine::SF_CRUSH | TermLine::SF_EXPAND, '-' );
     outstr.lhs << s << ' ';
 
@@ -130,12 +145,7 @@ void OutNormal::displayProgress ( const std::string & s, int percent )
     ++cursor;
     outstr.rhs << '[' << cursor.current() << ']';
 
-    if ( _oneup )
-      cout << ansi::tty::clearLN << ansi::tty::cursorUP;
-    cout << ansi::tty::clearLN;
-
-    std::string outline( outstr.get( termwidth() ) );
-    cout << outline << std::flush;
+    _progressLine.draw( outstr.get( termwidth() ) );
     // no _oneup if CRUSHed // _oneup = ( outline.length() > termwidth() );
   }
   else
@@ -144,23 +154,21 @@ void OutNormal::displayProgress ( const std::string & s, int percent )
 
 // ----------------------------------------------------------------------------
 
-void OutNormal::displayTick( const std::string & s )
+void OutNormal::displayTick( const std::string & s, bool force )
 {
   static AliveCursor cursor;
 
   if ( _isatty )
   {
+    if ( ! ( progressLineDue() || force ) )
+      return;
+
     TermLine outstr( TermLine::SF_CRUSH | TermLine::SF_EXPAND, '-' );
     ++cursor;
     outstr.lhs << s << ' ';
     outstr.rhs << '[' << cursor.current() << ']';
 
-    if( _oneup )
-      cout << ansi::tty::clearLN << ansi::tty::cursorUP;
-    cout << ansi::tty::clearLN;
-
-    std::string outline( outstr.get( termwidth() ) );
-    cout << outline << std::flush;
+    _progressLine.draw( outstr.get( termwidth() ) );
     // no _oneup if CRUSHed // _oneup = ( outline.length() > termwidth() );
   }
   else
@@ -178,9 +186,10 @@ void OutNormal::progressStart( const std::string & id, const std::string & label
     cout << label << " [";
 
   if ( is_tick )
-    displayTick( label );
+    displayTick( label, true );
   else
-    displayProgress( label, 0 );
+    displayProgress( label, 0, true );
+  flush();
 
   _newline = false;
 }
@@ -209,6 +218,7 @@ void OutNormal::progressEnd( const std::string & id, const std::string & label,
   TermLine outstr( TermLine::SF_CRUSH | TermLine::SF_EXPAND, '.' );
   if ( _isatty )
   {
+    _progressLine.reset();	// the final line is written completely
     if ( _oneup )
     {
       cout << ansi::tty::clearLN << ansi::tty::cursorUP;
@@ -229,36 +239,140 @@ void OutNormal::progressEnd( const std::string & id, const std::string & label,
   outstr.rhs << ']';
 
   std::string outline( outstr.get( termwidth() ) );
-  cout << outline << endl << std::flush;
+  cout << outline << endl;
   _newline = true;
 
   if ( !error && _use_colors )
     cout << ColorContext::DEFAULT;
+  flush();
 }
 
 // progress with download rate
+std::string OutNormal::dwnldLabel( const Url & uri ) const
+{
+  if ( verbosity() == DEBUG )
+    return uri.asString();
+  return Pathname(uri.getPathName()).basename();
+}
+
+std::string OutNormal::dwnldLine( const out::DownloadSlots::Slot & slot_r, char cursor_r )
+{
+  TermLine outstr( TermLine::SF_CRUSH | TermLine::SF_EXPAND, '-' );
+  outstr.lhs << _("Retrieving:") << " " << slot_r._label << ' ';
+
+  // dont display percents if invalid
+  if ( slot_r._percent >= 0 && slot_r._percent <= 100 )
+    outstr.percentHint = slot_r._percent;
+
+  outstr.rhs << '[' << cursor_r;
+  if ( slot_r._rate > 0 )
+    outstr.rhs << " (" << ByteCount(slot_r._rate) << "/s)";
+  outstr.rhs << ']';
+
+  return outstr.get( termwidth() );
+}
+
+void OutNormal::drawDownloads()
+{
+  static AliveCursor cursor;
+  ++cursor;
+
+  // Aggregate header line, followed by a line per active download
+  // (limited, so the block fits on the screen).
+  static const unsigned maxLines = 8;
+  std::vector<std::string> lines;
+  {
+    unsigned cnt = _dwnldSlots.size();
+    TermLine outstr( TermLine::SF_CRUSH | TermLine::SF_EXPAND, ' ' );
+    // translators: header of the progress lines of concurrent downloads; %1% is the number of files
+    outstr.lhs << str::Format( PL_("Retrieving %1% file", "Retrieving %1% files", cnt) ) % cnt << ' ';
+    outstr.rhs << '[';
+    long rate = _dwnldSlots.totalRate();
+    if ( rate > 0 )
+      outstr.rhs << ByteCount(rate) << "/s";
+    long eta = _dwnldSlots.eta();
+    if ( eta >= 0 )
+    {
+      if ( rate > 0 )
+	outstr.rhs << ", ";
+      // translators: estimated time until all concurrent downloads are done; %1% is minutes:seconds
+      outstr.rhs << str::Format(_("%1% left")) % str::form( "%ld:%02ld", eta / 60, eta % 60 );
+    }
+    else if ( rate <= 0 )
+      outstr.rhs << cursor.current();
+    outstr.rhs << ']';
+    lines.push_back( outstr.get( termwidth() ) );
+  }
+  for ( const auto & slot : _dwnldSlots.slots() )
+  {
+    if ( lines.size() > maxLines )
+      break;
+    lines.push_back( dwnldLine( slot, cursor.current() ) );
+  }
+
+  if ( _newline )	// something else was printed since
+    _dwnldLines = 0;
+  // overwrite the block in place (or the single progress line)
+  for ( unsigned i = 1; i < _dwnldLines; ++i )
+    cout << ansi::tty::cursorUP;
+  for ( unsigned i = 0; i < lines.size(); ++i )
+  {
+    if ( i )
+      cout << '\n';
+    cout << ansi::tty::clearLN << lines[i];
+  }
+  cout << std::flush;
+
+  _dwnldLines = lines.size();
+  _dwnldDrawn = out::ProgressLine::Clock::now();
+  _progressLine.reset();
+  _newline = false;
+}
+
+void OutNormal::clearDownloads()
+{
+  if ( _dwnldLines && !_newline )
+  {
+    for ( unsigned i = 1; i < _dwnldLines; ++i )
+      cout << ansi::tty::clearLN << ansi::tty::cursorUP;
+    cout << ansi::tty::clearLN;
+  }
+  _dwnldLines = 0;
+}
+
 void OutNormal::dwnldProgressStart( const Url & uri )
 {
   if ( verbosity() < NORMAL )
     return;
 
-  if ( _isatty )
-    cout << ansi::tty::clearLN;
+  std::lock_guard<std::mutex> guard( _dwnldMutex );
+  _dwnldSlots.start( uri.asString(), dwnldLabel( uri ) );
+
+  if ( _isatty && _dwnldSlots.size() > 1 )
+  {
+    drawDownloads();
+    return;
+  }
+  if ( !_isatty && _dwnldSlots.size() > 1 && !_newline )
+    cout << endl;	// another download is in progress
 
   TermLine outstr( TermLine::SF_CRUSH | TermLine::SF_EXPAND, '-' );
-  outstr.lhs << _("Retrieving:") << ' ';
-  if ( verbosity() == DEBUG )
-    outstr.lhs << uri;
-  else
-    outstr.lhs << Pathname(uri.getPathName()).basename();
-  outstr.lhs << ' ';
+  outstr.lhs << _("Retrieving:") << ' ' << dwnldLabel( uri ) << ' ';
   if (_isatty)
     outstr.rhs << '[' << _("starting") << ']';
   else
     outstr.rhs << '[' ;
 
   std::string outline( outstr.get( termwidth() ) );
-  cout << outline << std::flush;
+  if ( _isatty )
+  {
+    if ( _newline )
+      _progressLine.reset();
+    _progressLine.draw( outline );
+  }
+  else
+    cout << outline;
+  flush();
   // no _oneup if CRUSHed // _oneup = (outline.length() > termwidth());
 
   _newline = false;
@@ -269,37 +383,37 @@ void OutNormal::dwnldProgress( const Url & uri, int value, long rate )
   if ( verbosity() < NORMAL )
     return;
 
+  std::lock_guard<std::mutex> guard( _dwnldMutex );
+  bool known = _dwnldSlots.update( uri.asString(), value, rate );
+
   if ( !_isatty )
   {
     cout << '.' << std::flush;
     return;
   }
 
-  if( _oneup )
-    cout << ansi::tty::clearLN << ansi::tty::cursorUP;
-  cout << ansi::tty::clearLN;
-
-  TermLine outstr( TermLine::SF_CRUSH | TermLine::SF_EXPAND, '-' );
-  outstr.lhs << _("Retrieving:") << " ";
-  if ( verbosity() == DEBUG )
-    outstr.lhs << uri;
-  else
-    outstr.lhs << Pathname(uri.getPathName()).basename();
-   outstr.lhs << ' ';
+  if ( _dwnldSlots.size() > 1 )
+  {
+    if ( _newline || out::ProgressLine::Clock::now() - _dwnldDrawn >= std::chrono::milliseconds( 100 ) )
+      drawDownloads();
+    return;
+  }
 
-  // dont display percents if invalid
-  if ( value >= 0 && value <= 100 )
-    outstr.percentHint = value;
+  if ( ! progressLineDue() )
+    return;
 
+  out::DownloadSlots::Slot slot;
+  if ( known )
+    slot = _dwnldSlots.slots().front();
+  else
+  {
+    slot._label = dwnldLabel( uri );
+    slot._percent = value;
+    slot._rate = rate;
+  }
   static AliveCursor cursor;
   ++cursor;
-  outstr.rhs << '[' << cursor.current();
-  if ( rate > 0 )
-    outstr.rhs << " (" << ByteCount(rate) << "/s)";
-  outstr.rhs << ']';
-
-  std::string outline( outstr.get( termwidth() ) );
-  cout << outline << std::flush;
+  _progressLine.draw( dwnldLine( slot, cursor.current() ) );
   // no _oneup if CRUSHed // _oneup = (outline.length() > termwidth());
   _newline = false;
 }
@@ -309,21 +423,21 @@ void OutNormal::dwnldProgressEnd( const Url & uri, long rate, TriBool error )
   if ( verbosity() < NORMAL )
     return;
 
+  std::lock_guard<std::mutex> guard( _dwnldMutex );
+  _dwnldSlots.finish( uri.asString() );
+
   if ( bool(!error) && _use_colors )
     cout << ColorContext::MSG_STATUS;
 
   TermLine outstr( TermLine::SF_CRUSH | TermLine::SF_EXPAND, '.' );
   if ( _isatty )
   {
+    clearDownloads();
+    _progressLine.reset();	// the final line is written completely
     if( _oneup )
       cout << ansi::tty::clearLN << ansi::tty::cursorUP;
     cout << ansi::tty::clearLN;
-    outstr.lhs << _("Retrieving:") << " ";
-    if ( verbosity() == DEBUG )
-      outstr.lhs << uri;
-    else
-      outstr.lhs << Pathname(uri.getPathName()).basename();
-    outstr.lhs << ' ';
+    outstr.lhs << _("Retrieving:") << " " << dwnldLabel( uri ) << ' ';
     outstr.rhs << '[';
     if ( indeterminate( error ) )
       // Translator: download progress bar result: "........[not found]"
@@ -336,18 +450,42 @@ void OutNormal::dwnldProgressEnd( const Url & uri, long rate, TriBool error )
       outstr.rhs << _("done");
   }
   else
+  {
+    if ( !_dwnldSlots.empty() )	// others are in progress: tell which one is done
+    {
+      if ( !_newline )
+	cout << endl;
+      outstr.lhs << _("Retrieving:") << " " << dwnldLabel( uri ) << ' ';
+      outstr.rhs << '[';
+    }
     outstr.rhs << ( indeterminate( error ) ? _("not found") : ( error ? _("error") : _("done") ) );
+  }
 
   if ( rate > 0 )
     outstr.rhs << " (" << ByteCount(rate) << "/s)";
   outstr.rhs << ']';
 
   std::string outline( outstr.get( termwidth() ) );
-  cout << outline << endl << std::flush;
+  cout << outline << endl;
   _newline = true;
 
   if ( bool(!error) && _use_colors )
     cout << ColorContext::DEFAULT;
+
+  // the remaining downloads go below
+  if ( _isatty && !_dwnldSlots.empty() )
+  {
+    if ( _dwnldSlots.size() > 1 )
+      drawDownloads();
+    else
+    {
+      static AliveCursor cursor;
+      ++cursor;
+      _progressLine.draw( dwnldLine( _dwnldSlots.slots().front(), cursor.current() ) );
+      _newline = false;
+    }
+  }
+  flush();
 }
 
 void OutNormal::prompt( PromptId id, const std::string & prompt, const PromptOptions & poptions, const std::string & startdesc )
@@ -404,7 +542,8 @@ void OutNormal::prompt( PromptId id, const std::string & prompt, const PromptOpt
     }
   }
 
-  std::cout << pstr.str() << std::flush;
+  std::cout << pstr.str();
+  flush();
   // prompt ends with newline (user hits <enter>) unless exited abnormaly
   _newline = true;
 }
@@ -439,7 +578,8 @@ void OutNormal::promptHelp( const PromptOptions & poptions )
   }
 
   ColorStream cout( std::cout, ColorContext::PROMPT ); // scoped color on std::cout
-  cout << endl << ColorString( poptions.optionString() ) << ": " << std::flush;
+  cout << endl << ColorString( poptions.optionString() ) << ": ";
+  flush();
   // prompt ends with newline (user hits <enter>) unless exited abnormaly
   _newline = true;
 }
@@ -8,7 +8,11 @@
 #ifndef OUTNORMAL_H_
 #define OUTNORMAL_H_
 
+#include <mutex>
+
 #include "Out.h"
+#include "DownloadSlots.h"
+#include "ProgressLine.h"
 #include <termios.h>
 #include <sys/ioctl.h>
 
@@ -85,8 +89,17 @@ protected:
 
 private:
   bool infoWarningFilter(Verbosity verbosity, Type mask);
-  void displayProgress(const std::string & s, int percent);
-  void displayTick(const std::string & s);
+  void displayProgress(const std::string & s, int percent, bool force = false);
+  void displayTick(const std::string & s, bool force = false);
+  /* Whether a progress line update should be drawn now (see out::ProgressLine) */
+  bool progressLineDue();
+
+  std::string dwnldLabel(const Url & uri) const;
+  std::string dwnldLine(const out::DownloadSlots::Slot & slot, char cursor);
+  /* Draw the aggregate header and a line per active download */
+  void drawDownloads();
+  /* Clear the lines written by drawDownloads */
+  void clearDownloads();
 
   bool _use_colors;
   bool _isatty;
@@ -95,6 +108,15 @@ private:
   bool _newline;
   /* True if the last output line was longer than the terminal width */
   bool _oneup;
+  /* The self-overwriting progress line (tty only) */
+  out::ProgressLine _progressLine;
+  /* The active downloads; if more than one, drawn as a block of lines */
+  out::DownloadSlots _dwnldSlots;
+  /* Number of lines written by the last drawDownloads */
+  unsigned _dwnldLines;
+  out::ProgressLine::Clock::time_point _dwnldDrawn;
+  /* Download callbacks may arrive concurrently */
+  std::mutex _dwnldMutex;
 };
 
 #endif /*OUTNORMAL_H_*/
@@ -63,6 +63,7 @@ void OutXML::error( const std::string & problem_desc, const std::string & hint )
 {
   cout << "<message type=\"error\">" << xml::escape( problem_desc )
        << "</message>" << endl;
+  flush();
   //! \todo hint
 }
 
@@ -80,6 +81,7 @@ void OutXML::error( const Exception & e, const std::string & problem_desc, const
 
   cout << "<message type=\"error\">" << xml::escape(s.str())
        << "</message>" << endl;
+  flush();
 }
 
 void OutXML::writeProgressTag( const std::string & id, const std::string & label, int value, bool done, bool error )
@@ -94,6 +96,7 @@ void OutXML::writeProgressTag( const std::string & id, const std::string & label
   else if ( value >= 0 )
     cout << " value=\"" << value << "\"";
   cout << "/>" << endl;
+  flush();
 }
 
 void OutXML::progressStart( const std::string & id, const std::string & label, bool has_range )
@@ -123,29 +126,35 @@ void OutXML::progressEnd( const std::string & id, const std::string& label, bool
 
 void OutXML::dwnldProgressStart( const Url & uri )
 {
+  std::lock_guard<std::mutex> guard( _dwnldMutex );
   cout << "<download"
     << " url=\"" << xml::escape(uri.asString()) << "\""
     << " percent=\"-1\""
     << " rate=\"-1\""
     << "/>" << endl;
+  flush();
 }
 
 void OutXML::dwnldProgress( const Url & uri, int value, long rate )
 {
+  std::lock_guard<std::mutex> guard( _dwnldMutex );
   cout << "<download"
     << " url=\"" << xml::escape(uri.asString()) << "\""
     << " percent=\"" << value << "\""
     << " rate=\"" << rate << "\""
     << "/>" << endl;
+  flush();
 }
 
 void OutXML::dwnldProgressEnd( const Url & uri, long rate, TriBool error )
 {
+  std::lock_guard<std::mutex> guard( _dwnldMutex );
   cout << "<download"
     << " url=\"" << xml::escape(uri.asString()) << "\""
     << " rate=\"" << rate << "\""
     << " done=\"" << bool(!error) << "\""
     << "/>" << endl;
+  flush();
 }
 
 void OutXML::searchResult( const Table & table_r )
@@ -153,12 +162,13 @@ void OutXML::searchResult( const Table & table_r )
   cout << "<search-result version=\"0.0\">" << endl;
   cout << "<solvable-list>" << endl;
 
-  const Table::container & rows( table_r.rows() );
+  const Table::Rows & rows( table_r.rows() );
   if ( ! rows.empty() )
   {
     //
     // *** CAUTION: It's a mess, but must match the header list defined
-    //              in FillSearchTableSolvable ctor (search.cc)
+    //              in FillSearchTableSolvable ctor (search.cc) and the
+    //              attributes written by XmlSearchResult (search.cc)
     // We derive the XML tag from the header, applying some translation
     // hence and there.
     std::vector<std::string> header;
@@ -177,28 +187,27 @@ void OutXML::searchResult( const Table & table_r )
       }
     }
 
-    for_( it, rows.begin(), rows.end() )
+    for ( const Table::RowRef & row : rows )
     {
       cout << "<solvable";
-      const TableRow::container & cols( it->columns() );
-      unsigned cidx = 0;
-      for_( cit, cols.begin(), cols.end() )
+      for ( unsigned cidx = 0; cidx < row.size(); ++cidx )
       {
+	boost::string_ref col( row[cidx] );
 	cout << ' ' << (cidx < header.size() ? header[cidx] : "?" ) << "=\"";
 	if ( cidx == 0 )
 	{
-	  if ( (*cit)[0] == 'i' || (*cit)[0] == 'I' )	// test 1st char as locked is "iL"/"IL"
+	  char first = col.empty() ? '\0' : col[0];
+	  if ( first == 'i' || first == 'I' )	// test 1st char as locked is "iL"/"IL"
 	    cout << "installed\"";
-	  else if ( (*cit)[0] == 'v' )	// test 1st char as locked is "vL"
+	  else if ( first == 'v' )	// test 1st char as locked is "vL"
 	    cout << "other-version\"";
 	  else
 	    cout << "not-installed\"";
 	}
 	else
 	{
-	  cout << xml::escape(*cit) << '"';
+	  cout << xml::escape( col.to_string() ) << '"';
 	}
-	++cidx;
       }
       cout << "/>" << endl;
     }
@@ -230,6 +239,7 @@ void OutXML::prompt( PromptId id, const std::string & prompt, const PromptOption
     cout << "/>" << endl;
   }
   cout << "</prompt>" << endl;
+  flush();
 }
 
 void OutXML::promptHelp( const PromptOptions & poptions )
@@ -1,6 +1,8 @@
 #ifndef OUTXML_H_
 #define OUTXML_H_
 
+#include <mutex>
+
 #include "Out.h"
 
 class OutXML : public Out
@@ -54,6 +56,9 @@ private:
   void writeProgressTag(const std::string & id,
                         const std::string & label,
                         int value, bool done, bool error = false);
+
+  /* Download callbacks may arrive concurrently; keep each tag in one piece */
+  std::mutex _dwnldMutex;
 };
 
 #endif /*OUTXML_H_*/
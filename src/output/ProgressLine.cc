@@ -0,0 +1,59 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+#include <iostream>
+
+#include "utils/text.h"
+#include "ProgressLine.h"
+
+namespace out
+{
+  namespace
+  {
+    inline bool hasEscape( const std::string & line_r )
+    { return line_r.find( '\033' ) != std::string::npos; }
+
+    /** UTF-8 continuation byte (not the start of a char) */
+    inline bool isContinuation( const std::string & str_r, std::string::size_type pos_r )
+    { return pos_r < str_r.size() && ( str_r[pos_r] & 0xC0 ) == 0x80; }
+  } // namespace
+
+  ProgressLine::ProgressLine( std::ostream & str_r, Clock::duration interval_r )
+  : _str( str_r )
+  , _interval( interval_r )
+  , _active( false )
+  {}
+
+  void ProgressLine::draw( const std::string & line_r, Clock::time_point now_r )
+  {
+    _last = now_r;
+    if ( _active && line_r == _line )
+      return;
+
+    if ( !_active || hasEscape( line_r ) || hasEscape( _line ) )
+    {
+      _str << "\033[2K\r" << line_r;	// ansi::tty::clearLN
+    }
+    else
+    {
+      std::string::size_type pos = 0;
+      while ( pos < line_r.size() && pos < _line.size() && line_r[pos] == _line[pos] )
+	++pos;
+      while ( pos && ( isContinuation( line_r, pos ) || isContinuation( _line, pos ) ) )
+	--pos;	// not within a multibyte char
+
+      _str << '\r';
+      if ( size_t col = mbs_width( boost::string_ref( line_r ).substr( 0, pos ) ) )
+	_str << "\033[" << col << 'C';	// cursor right (columns, not chars)
+      _str << line_r.substr( pos );
+      if ( mbs_width( line_r ) < mbs_width( _line ) )
+	_str << "\033[K";		// clear to end of line
+    }
+    _str << std::flush;
+    _line = line_r;
+    _active = true;
+  }
+} // namespace out
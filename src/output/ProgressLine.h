@@ -0,0 +1,61 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+#ifndef ZYPPER_OUTPUT_PROGRESSLINE_H
+#define ZYPPER_OUTPUT_PROGRESSLINE_H
+
+#include <chrono>
+#include <iosfwd>
+#include <string>
+
+namespace out
+{
+  ///////////////////////////////////////////////////////////////////
+  /// \class ProgressLine
+  /// \brief Self-overwriting progress line on a tty.
+  ///
+  /// Progress callbacks (esp. rpm and download ones) may fire far more
+  /// often than a terminal is able to display. Callers should ask \ref due
+  /// before even formatting the line, so updates are coalesced to at most
+  /// one frame per interval (10 Hz by default). Start and end of a progress
+  /// are drawn unconditionally.
+  ///
+  /// \ref draw compares the new line to the one currently on screen and
+  /// rewrites just the changed tail (moving the cursor behind the unchanged
+  /// prefix). Lines containing ANSI SGR sequences are always rewritten
+  /// completely.
+  ///
+  /// The line on screen is assumed to be unchanged between two \ref draw.
+  /// Call \ref reset if anything else was written in between.
+  ///////////////////////////////////////////////////////////////////
+  class ProgressLine
+  {
+  public:
+    typedef std::chrono::steady_clock Clock;
+
+    explicit ProgressLine( std::ostream & str_r, Clock::duration interval_r = std::chrono::milliseconds( 100 ) );
+
+    /** Whether the next frame is due (or nothing was drawn yet). */
+    bool due( Clock::time_point now_r = Clock::now() ) const
+    { return !_active || now_r - _last >= _interval; }
+
+    /** Replace the current line by \a line_r. */
+    void draw( const std::string & line_r, Clock::time_point now_r = Clock::now() );
+
+    /** Forget the line on screen; the next \ref draw writes a complete line. */
+    void reset()
+    { _active = false; _line.clear(); }
+
+  private:
+    std::ostream & _str;
+    Clock::duration _interval;
+    Clock::time_point _last;
+    std::string _line;	///< as on screen
+    bool _active;
+  };
+} // namespace out
+
+#endif // ZYPPER_OUTPUT_PROGRESSLINE_H
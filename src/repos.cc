@@ -28,6 +28,7 @@
 #include "Table.h"
 #include "utils/messages.h"
 #include "utils/misc.h"
+#include "utils/TraceFile.h"
 #include "repos.h"
 #include "global-settings.h"
 
@@ -199,6 +200,7 @@ void repoPrioSummary( Zypper & zypper )
 
 bool refresh_raw_metadata( Zypper & zypper, const RepoInfo & repo, bool force_download )
 {
+  TraceFile::Scope trace( "refresh " + repo.alias(), { { "repo", repo.alias() } } );
   RuntimeData & gData( zypper.runtimeData() );
   gData.current_repo = repo;
   bool do_refresh = false;
@@ -410,6 +412,7 @@ bool refresh_raw_metadata( Zypper & zypper, const RepoInfo & repo, bool force_do
 
 bool build_cache( Zypper & zypper, const RepoInfo & repo, bool force_build )
 {
+  TraceFile::Scope trace( "build cache " + repo.alias(), { { "repo", repo.alias() } } );
   if ( force_build )
     zypper.out().info(_("Forcing building of repository cache") );
 
@@ -1812,7 +1815,10 @@ void load_repo_resolvables( Zypper & zypper )
         }
       }
 
-      manager.loadFromCache( repo );
+      {
+	TraceFile::Scope trace( "load " + repo.alias(), { { "repo", repo.alias() } } );
+	manager.loadFromCache( repo );
+      }
 
       // check that the metadata is not outdated
       // feature #301904
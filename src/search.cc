@@ -1,4 +1,7 @@
 #include <iostream>
+#include <map>
+#include <cstring>
+#include <algorithm>
 
 #include <zypp/ZYpp.h> // for ResPool::instance()
 
@@ -22,24 +25,180 @@
 
 extern ZYpp::Ptr God;
 
+///////////////////////////////////////////////////////////////////
+// class XmlSearchResult
+///////////////////////////////////////////////////////////////////
+
+namespace
+{
+  /** The XML status attribute value for a status indicator. */
+  inline const char * xmlStatus( const char * statusIndicator_r )
+  {
+    switch ( *statusIndicator_r )	// test 1st char as locked is "iL"/"IL"/"vL"
+    {
+      case 'i':
+      case 'I':
+	return "installed";
+      case 'v':
+	return "other-version";
+    }
+    return "not-installed";
+  }
+} // namespace
+
+XmlSearchResult::XmlSearchResult( std::ostream & str_r, SortOrder order_r )
+: _str( str_r )
+, _order( order_r )
+, _rows( 0 )
+, _opened( false )
+, _closed( false )
+{}
+
+XmlSearchResult::~XmlSearchResult()
+{ finish(); }
+
+void XmlSearchResult::add( const PoolItem & pi_r, const char * statusIndicator_r, ui::Selectable::picklist_size_type picklistPos_r )
+{
+  Row row { pi_r.satSolvable(), picklistPos_r, nullptr, statusIndicator_r, std::string() };
+  if ( _order == Unsorted )
+    write( row );
+  else
+  {
+    row._name = pi_r->name();
+    _pending.push_back( std::move(row) );
+  }
+  ++_rows;
+}
+
+void XmlSearchResult::add( const ui::Selectable::constPtr & sel_r, const char * statusIndicator_r )
+{
+  Row row { sat::Solvable(), ui::Selectable::picklistNoPos, sel_r, statusIndicator_r, std::string() };
+  if ( _order == Unsorted )
+    write( row );
+  else
+  {
+    row._name = sel_r->name();
+    _pending.push_back( std::move(row) );
+  }
+  ++_rows;
+}
+
+void XmlSearchResult::finish()
+{
+  if ( _closed || !_rows )
+    return;
+
+  if ( _order != Unsorted )
+  {
+    // same order as Table::sort by the corresponding columns
+    auto byCSI = []( const Row & lhs, const Row & rhs ) {
+      if ( lhs._sel || rhs._sel )
+	return 0;	// no user data: equal
+      return csidetail::simpleTypeComp<SolvableCSI>( SolvableCSI( lhs._solv, lhs._picklistPos ),
+						     SolvableCSI( rhs._solv, rhs._picklistPos ) );
+    };
+    std::vector<const std::string *> repos;
+    if ( _order == ByRepo )
+    {
+      // lookup once per row, not per comparison
+      repos.reserve( _pending.size() );
+      for ( const Row & row : _pending )
+	repos.push_back( row._sel ? nullptr : &repoString( row._solv ) );
+    }
+    std::vector<uint32_t> order( _pending.size() );
+    for ( uint32_t i = 0; i < order.size(); ++i )
+      order[i] = i;
+    std::stable_sort( order.begin(), order.end(), [&]( uint32_t lhs, uint32_t rhs ) {
+      const Row & l( _pending[lhs] );
+      const Row & r( _pending[rhs] );
+      if ( _order == ByRepo && repos[lhs] != repos[rhs] )
+      {
+	if ( !repos[lhs] || !repos[rhs] )
+	  return !repos[lhs];	// missing column first
+	int cmp = repos[lhs]->compare( *repos[rhs] );
+	if ( cmp )
+	  return cmp < 0;
+      }
+      int cmp = l._name.compare( r._name );
+      if ( cmp || _order == ByName )
+	return cmp < 0;
+      return byCSI( l, r ) < 0;
+    } );
+    for ( uint32_t i : order )
+      write( _pending[i] );
+    _pending.clear();
+  }
+
+  _str << "</solvable-list>" << endl;
+  _str << "</search-result>" << endl;
+  _closed = true;
+}
+
+void XmlSearchResult::write( const Row & row_r )
+{
+  if ( ! _opened )
+  {
+    _str << "<search-result version=\"0.0\">" << endl;
+    _str << "<solvable-list>" << endl;
+    _opened = true;
+  }
+
+  //
+  // *** CAUTION: It's a mess, but the attributes must match the ones
+  //              OutXML::searchResult derives from the Table columns
+  //              in FillSearchTable* (see below).
+  //
+  _str << "<solvable status=\"" << xmlStatus( row_r._status ) << '"';
+  if ( row_r._sel )
+  {
+    const ui::Selectable & sel( *row_r._sel );
+    _str << " name=\"" << xml::escape( sel.name() ) << '"'
+	 << " summary=\"" << xml::escape( sel.theObj()->summary() ) << '"'
+	 << " kind=\"" << xml::escape( kind_to_string_localized( sel.kind(), 1 ) ) << '"';
+  }
+  else
+  {
+    const sat::Solvable & solv( row_r._solv );
+    _str << " name=\"" << xml::escape( solv.name() ) << '"'
+	 << " kind=\"" << xml::escape( kind_to_string_localized( solv.kind(), 1 ) ) << '"'
+	 << " edition=\"" << xml::escape( solv.edition().asString() ) << '"'
+	 << " arch=\"" << xml::escape( solv.arch().asString() ) << '"'
+	 << " repository=\"" << xml::escape( repoString( solv ) ) << '"';
+  }
+  _str << "/>" << endl;
+}
+
+const std::string & XmlSearchResult::repoString( const sat::Solvable & solv_r )
+{
+  auto it = _repoStrings.find( solv_r.repository() );
+  if ( it == _repoStrings.end() )
+    it = _repoStrings.emplace( solv_r.repository(),
+			       solv_r.isSystem()
+			       ? (std::string("(") + _("System Packages") + ")")
+			       : solv_r.repository().asUserString() ).first;
+  return it->second;
+}
+
 ///////////////////////////////////////////////////////////////////
 // class FillSearchTableSolvable
 ///////////////////////////////////////////////////////////////////
 
+FillSearchTableSolvable::FillSearchTableSolvable( XmlSearchResult & xml_r, TriBool instNotinst_r )
+: _table( nullptr )
+, _xml( &xml_r )
+, _instNotinst( instNotinst_r )
+{ initRepoFilter(); }
+
 FillSearchTableSolvable::FillSearchTableSolvable( Table & table_r, TriBool instNotinst_r )
 : _table( &table_r )
+, _xml( nullptr )
 , _instNotinst( instNotinst_r )
 {
-  Zypper & zypper( Zypper::instance() );
-  if ( InitRepoSettings::instance()._repoFilter.size() )
-  {
-    for ( const auto & ri : zypper.runtimeData().repos )
-      _repos.insert( ri.alias() );
-  }
+  initRepoFilter();
 
   //
   // *** CAUTION: It's a mess, but adding/changing colums here requires
-  //              adapting OutXML::searchResult !
+  //              adapting OutXML::searchResult and XmlSearchResult !
   //
   *_table << ( TableHeader()
 	  // translators: S for 'installed Status'
@@ -56,6 +215,16 @@ FillSearchTableSolvable::FillSearchTableSolvable( Table & table_r, TriBool instN
 	  << N_("Repository") );
 }
 
+void FillSearchTableSolvable::initRepoFilter()
+{
+  Zypper & zypper( Zypper::instance() );
+  if ( InitRepoSettings::instance()._repoFilter.size() )
+  {
+    for ( const auto & ri : zypper.runtimeData().repos )
+      _repos.insert( ri.alias() );
+  }
+}
+
 bool FillSearchTableSolvable::operator()( const PoolItem & pi_r ) const
 {
   // --repo => we only want the repo resolvables, not @System (bnc #467106)
@@ -68,24 +237,24 @@ bool FillSearchTableSolvable::operator()( const PoolItem & pi_r ) const
 
   // NOTE The query delivers available items even if _instNotinst == true.
   // That's why we can/must discard installed items, if an identical available
-  // is present. Most probably done to get the correct repo. (but not efficient).
-  // As we need the picklistPos anyway we can use it to dicard picklistNoPos ones.
-  ui::Selectable::Ptr sel { ui::Selectable::get( pi_r ) };
-  ui::Selectable::picklist_size_type picklistPos { sel->picklistPos( pi_r ) };
+  // is present. Most probably done to get the correct repo. The StatusIndicatorCache
+  // remembers the picklistPos per Selectable, so the picklistNoPos ones are
+  // discarded by a lookup.
+  const StatusIndicatorCache::Entry & status { StatusIndicatorCache::instance()[pi_r] };
+  ui::Selectable::picklist_size_type picklistPos { status._picklistPos };
 
   if ( picklistPos == ui::Selectable::picklistNoPos )
     return false;
 
   // On the fly filter unwanted according to _instNotinst
-  const char *statusIndicator = nullptr;
-  if ( indeterminate(_instNotinst)  )
-    statusIndicator = computeStatusIndicator( pi_r, sel );
-  else
+  const char *statusIndicator = status._statusIndicator;
+  if ( ! indeterminate(_instNotinst) && (bool)_instNotinst != status._iType )
+    return false;
+
+  if ( _xml )
   {
-    bool iType;
-    statusIndicator = computeStatusIndicator( pi_r, sel, &iType );
-    if ( (bool)_instNotinst != iType )
-      return false;
+    _xml->add( pi_r, statusIndicator, picklistPos );
+    return true;
   }
 
   TableRow row;
@@ -114,8 +283,11 @@ bool FillSearchTableSolvable::operator()( const PoolQuery::const_iterator & it_r
   if ( ! operator()(*it_r) )
     return false;	// no row was added due to filter
 
+  if ( _xml )
+    return true;	// details are not part of the XML output
+
   // add the details about matches to last row
-  TableRow & lastRow( _table->rows().back() );
+  TableRow & lastRow( _table->lastRow() );
 
   // don't show details for patterns with user visible flag not set (bnc #538152)
   if ( it_r->kind() == ResKind::pattern )
@@ -162,8 +334,11 @@ bool FillSearchTableSolvable::operator()(const sat::Solvable &solv_r, const sat:
   if ( ! operator()(solv_r) )
     return false;	// no row was added due to filter
 
+  if ( _xml )
+    return true;	// details are not part of the XML output
+
   // add the details about matches to last row
-  TableRow & lastRow( _table->rows().back() );
+  TableRow & lastRow( _table->lastRow() );
 
   // don't show details for patterns with user visible flag not set (bnc #538152)
   if ( solv_r.kind() == ResKind::pattern )
@@ -184,14 +359,22 @@ bool FillSearchTableSolvable::operator()(const sat::Solvable &solv_r, const sat:
 
 ///////////////////////////////////////////////////////////////////
 
+FillSearchTableSelectable::FillSearchTableSelectable( XmlSearchResult & xml_r, TriBool installed_only )
+: _table( nullptr )
+, _xml( &xml_r )
+, _instNotinst( installed_only )
+, _tagForeign( InitRepoSettings::instance()._repoFilter.size() )
+{}
+
 FillSearchTableSelectable::FillSearchTableSelectable( Table & table, TriBool installed_only )
 : _table( &table )
+, _xml( nullptr )
 , _instNotinst( installed_only )
 , _tagForeign( InitRepoSettings::instance()._repoFilter.size() )
 {
   //
   // *** CAUTION: It's a mess, but adding/changing colums here requires
-  //              adapting OutXML::searchResult !
+  //              adapting OutXML::searchResult and XmlSearchResult !
   //
   *_table << ( TableHeader()
 	  // translators: S for installed Status
@@ -214,15 +397,15 @@ bool FillSearchTableSelectable::operator()( const ui::Selectable::constPtr & s )
     return true;
 
   // On the fly filter unwanted according to _instNotinst
-  const char *statusIndicator = nullptr;
-  if ( indeterminate(_instNotinst)  )
-    statusIndicator = computeStatusIndicator( *s, _tagForeign );
-  else
+  bool iType;
+  const char *statusIndicator = cachedStatusIndicator( *s, _tagForeign, &iType );
+  if ( ! indeterminate(_instNotinst) && (bool)_instNotinst != iType )
+    return true;
+
+  if ( _xml )
   {
-    bool iType;
-    statusIndicator = computeStatusIndicator( *s, _tagForeign, &iType );
-    if ( (bool)_instNotinst != iType )
-      return true;
+    _xml->add( s, statusIndicator );
+    return true;
   }
 
   *_table << ( TableRow()
@@ -328,7 +511,7 @@ static void list_pattern_table( Zypper & zypper, SolvableFilterMode mode_r )
       continue;
 
     tbl << ( TableRow()
-	<< computeStatusIndicator( pi )
+	<< cachedStatusIndicator( pi )
 	<< pi.name()
 	<< pi.edition()
 	<< piRepoName
@@ -354,7 +537,17 @@ void list_patterns(Zypper & zypper , SolvableFilterMode mode_r)
 void list_packages(Zypper & zypper , ListPackagesFlags flags_r )
 {
   MIL << "Going to list packages." << std::endl;
-  Table tbl;
+  // Collect lightweight handles only and measure the columns on the way;
+  // each table row is built once, while printing (the listing may be huge).
+  struct Item
+  {
+    PoolItem _pi;
+    const char * _status;
+    const std::string * _repo;
+  };
+  std::vector<Item> items;
+  std::map<Repository,std::string> repoNames;
+  StreamingTable stbl( cout );
 
   bool repofilter =  InitRepoSettings::instance()._repoFilter.size() ;	// suppress @System if repo filter is on
   bool showInstalled = !flags_r.testFlag( ListPackagesBits::HideInstalled ); //installed_only || !uninstalled_only;
@@ -368,6 +561,7 @@ void list_packages(Zypper & zypper , ListPackagesFlags flags_r )
   if ( check )
   {
     God->resolver()->resolvePool();
+    StatusIndicatorCache::instance().clear();	// items status changed
   }
   auto checkStatus = [=]( ResStatus status_r )->bool {
     return ( ( orphaned && status_r.isOrphaned() )
@@ -411,38 +605,54 @@ void list_packages(Zypper & zypper , ListPackagesFlags flags_r )
 	}
       }
 
-      const std::string & piRepoName( pi->repository().info().name() );
-      if ( repofilter && piRepoName == "@System" )
+      auto repoName = repoNames.find( pi.repository() );
+      if ( repoName == repoNames.end() )
+	repoName = repoNames.emplace( pi.repository(), pi->repository().info().name() ).first;
+      if ( repofilter && repoName->second == "@System" )
 	continue;
 
-      tbl << ( TableRow()
-	  << computeStatusIndicator( pi, sel )
-	  << piRepoName
-	  << pi->name()
-          << pi->edition().asString()
-	  << pi->arch().asString() );
+      const char * status = cachedStatusIndicator( pi );
+      stbl.measure( 0, status );
+      stbl.measure( 1, repoName->second );
+      stbl.measure( 2, pi.ident().c_str() );
+      stbl.measure( 3, pi.edition().c_str() );
+      stbl.measure( 4, pi.arch().c_str() );
+      items.push_back( { pi, status, &repoName->second } );
     }
   }
 
-  if ( tbl.empty() )
+  if ( items.empty() )
     zypper.out().info(_("No packages found.") );
   else
   {
+    if ( flags_r.testFlag( ListPackagesBits::SortByRepo ) )
+      std::stable_sort( items.begin(), items.end(), []( const Item & lhs, const Item & rhs ) {
+	return *lhs._repo < *rhs._repo;	// Repo
+      } );
+    else
+      std::stable_sort( items.begin(), items.end(), []( const Item & lhs, const Item & rhs ) {
+	return ::strcmp( lhs._pi.ident().c_str(), rhs._pi.ident().c_str() ) < 0;	// Name
+      } );
+
     // display the result, even if --quiet specified
-    tbl << ( TableHeader()
+    stbl.table() << ( TableHeader()
 	// translators: S for installed Status
 	<< N_("S")
 	<< N_("Repository")
 	<< N_("Name")
-	<< table::EditionStyleSetter( tbl, N_("Version") )
+	<< table::EditionStyleSetter( stbl.table(), N_("Version") )
 	<< N_("Arch") );
 
-    if ( flags_r.testFlag( ListPackagesBits::SortByRepo ) )
-      tbl.sort( 1 ); // Repo
-    else
-      tbl.sort( 2 ); // Name
-
-    cout << tbl;
+    for ( const auto & item : items )
+    {
+      const PoolItem & pi( item._pi );
+      stbl.print( TableRow()
+	  << item._status
+	  << *item._repo
+	  << pi->name()
+	  << pi->edition().asString()
+	  << pi->arch().asString() );
+    }
   }
 }
 
@@ -494,7 +704,7 @@ void list_product_table(Zypper & zypper , SolvableFilterMode mode_r)
     for ( const auto & pi : sel->picklist() )
     {
       bool iType;
-      const char * statusIndicator = computeStatusIndicator( pi, sel, &iType );
+      const char * statusIndicator = cachedStatusIndicator( pi, &iType );
       if ( ( installed_only && !iType ) || ( notinst_only && iType) )
 	continue;
 
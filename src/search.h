@@ -8,6 +8,10 @@
 #ifndef ZYPPERSEARCH_H_
 #define ZYPPERSEARCH_H_
 
+#include <iosfwd>
+#include <map>
+#include <vector>
+
 #include <zypp/TriBool.h>
 #include <zypp/PoolQuery.h>
 #include <zypp/base/Flags.h>
@@ -16,6 +20,74 @@
 #include "Table.h"
 #include "utils/misc.h"
 
+///////////////////////////////////////////////////////////////////
+/// \class XmlSearchResult
+/// \brief Write the XML search result directly from the solvables.
+///
+/// Used instead of a \ref Table in XML mode. Each row is written as
+/// \c <solvable> element with the same attributes \ref OutXML::searchResult
+/// derives from the table columns, but without formatting and storing the
+/// columns first. The \c <search-result> and \c <solvable-list> tags are
+/// written with the first row and closed by \ref finish (or the dtor).
+/// Nothing is written if no row was added.
+///
+/// Unless a \ref SortOrder is requested the rows are written as they
+/// arrive. Otherwise just a handle per row is remembered and the rows are
+/// written by \ref finish in the order a \ref Table sorted by the
+/// corresponding columns would print them.
+///////////////////////////////////////////////////////////////////
+class XmlSearchResult : private base::NonCopyable
+{
+public:
+  enum SortOrder
+  {
+    Unsorted,		///< as the rows arrive
+    ByName,		///< Name
+    ByNameVersion,	///< Name, SolvableCSI
+    ByRepo		///< Repository, Name, SolvableCSI
+  };
+
+  explicit XmlSearchResult( std::ostream & str_r, SortOrder order_r = Unsorted );
+
+  /** Calls \ref finish. */
+  ~XmlSearchResult();
+
+  /** Add a detailed row: status, name, kind, edition, arch, repository. */
+  void add( const PoolItem & pi_r, const char * statusIndicator_r,
+	    ui::Selectable::picklist_size_type picklistPos_r = ui::Selectable::picklistNoPos );
+
+  /** Add a selectable row: status, name, summary, kind. */
+  void add( const ui::Selectable::constPtr & sel_r, const char * statusIndicator_r );
+
+  /** Whether no row was added. */
+  bool empty() const
+  { return !_rows; }
+
+  /** Write pending rows and close the list (unless empty). */
+  void finish();
+
+private:
+  struct Row
+  {
+    sat::Solvable _solv;
+    ui::Selectable::picklist_size_type _picklistPos;
+    ui::Selectable::constPtr _sel;	///< selectable row if not NULL
+    const char * _status;
+    std::string _name;			///< sort key
+  };
+
+  void write( const Row & row_r );
+  const std::string & repoString( const sat::Solvable & solv_r );
+
+  std::ostream & _str;
+  SortOrder _order;
+  std::vector<Row> _pending;
+  std::map<Repository,std::string> _repoStrings;
+  unsigned _rows;
+  bool _opened;
+  bool _closed;
+};
+
 ///////////////////////////////////////////////////////////////////
 /// \class FillSearchTableSolvable
 /// \brief Functor for filling a detailed search output table.
@@ -23,6 +95,8 @@
 struct FillSearchTableSolvable
 {
   FillSearchTableSolvable( Table & table_r, TriBool instNotinst_r = indeterminate );
+  /** Write the rows to \a xml_r instead of a Table. */
+  FillSearchTableSolvable( XmlSearchResult & xml_r, TriBool instNotinst_r = indeterminate );
 
   /** Add this PoolItem if no filter applies */
   bool operator()( const PoolItem & pi_r ) const;
@@ -36,8 +110,11 @@ struct FillSearchTableSolvable
 private:
   std::string attribStr(const sat::SolvAttr &attr) const;
 
+  void initRepoFilter();
+
 private:
   Table * _table;		//!< The table used for output
+  XmlSearchResult * _xml;	//!< or the XML writer
   std::set<std::string> _repos;	//!< Filter --repo
   TriBool _instNotinst;		//!< Filter --[not-]installed
 
@@ -47,11 +124,15 @@ struct FillSearchTableSelectable
 {
   // the table used for output
   Table * _table;
+  XmlSearchResult * _xml;	//!< or the XML writer
   TriBool _instNotinst;
   bool _tagForeign;		//!< see NOTE in operator()
 
   FillSearchTableSelectable(
       Table & table, TriBool installed_only = indeterminate);
+  /** Write the rows to \a xml_r instead of a Table. */
+  FillSearchTableSelectable(
+      XmlSearchResult & xml_r, TriBool installed_only = indeterminate);
 
   bool operator()(const ui::Selectable::constPtr & s) const;
 };
@@ -24,8 +24,10 @@
 #include "utils/misc.h"
 #include "utils/prompt.h"	// Continue? and solver problem prompt
 #include "utils/pager.h"	// to view the summary
+#include "utils/PhaseProfile.h"
 #include "global-settings.h"
 #include "CommitSummary.h"
+#include "TransactionPlan.h"
 
 #include "solve-commit.h"
 #include "commands/needs-rebooting.h"
@@ -537,6 +539,12 @@ SolveAndCommitPolicy & SolveAndCommitPolicy::downloadMode( DownloadMode dlMode )
 DownloadMode SolveAndCommitPolicy::downloadMode() const
 { return _zyppCommitPolicy.downloadMode(); }
 
+const std::string &SolveAndCommitPolicy::savePlan() const
+{ return _savePlan; }
+
+SolveAndCommitPolicy &SolveAndCommitPolicy::savePlan( std::string file_r )
+{ _savePlan = std::move(file_r); return *this; }
+
 /** fate #300763
  * This is called after each commit to notify user about running processes that
  * use libraries or other files that have been removed since their execution.
@@ -640,17 +648,20 @@ void solve_and_commit ( Zypper &zypper, SolveAndCommitPolicy policy )
       while ( true )
       {
         bool success;
-        if ( zypper.command() == ZypperCommand::VERIFY )
-          success = verify(zypper);
-        else if ( zypper.command() == ZypperCommand::DIST_UPGRADE )
-        {
-          zypper.out().info(_("Computing distribution upgrade...") );
-          success = dist_upgrade(zypper);
-        }
-        else
         {
-          zypper.out().info(_("Resolving package dependencies...") );
-          success = resolve( zypper );
+          PhaseProfile::Scope profile( "resolve" );	// not including show_problems waiting for the user
+          if ( zypper.command() == ZypperCommand::VERIFY )
+            success = verify(zypper);
+          else if ( zypper.command() == ZypperCommand::DIST_UPGRADE )
+          {
+            zypper.out().info(_("Computing distribution upgrade...") );
+            success = dist_upgrade(zypper);
+          }
+          else
+          {
+            zypper.out().info(_("Resolving package dependencies...") );
+            success = resolve( zypper );
+          }
         }
 
         // go on, we've got solution or we don't want a solution (we want testcase)
@@ -676,6 +687,8 @@ void solve_and_commit ( Zypper &zypper, SolveAndCommitPolicy policy )
 
     // SHOW SUMMARY
 
+    PhaseProfile::instance().start( "summary" );
+    TraceFile::instance().begin( "summary", "summary", TraceFile::mainCategory );
     Summary summary( God->pool(), policy.summaryOptions() );
 
     if ( zypper.out().verbosity() == Out::HIGH )
@@ -697,7 +710,26 @@ void solve_and_commit ( Zypper &zypper, SolveAndCommitPolicy policy )
       summary.dumpAsXmlTo( cout );
     else
       summary.dumpTo( cout );
+    PhaseProfile::instance().stop( "summary" );
+    TraceFile::instance().end( "summary" );
+
+    // SAVE PLAN (even if not committing here)
 
+    if ( ! policy.savePlan().empty() )
+    {
+      try
+      {
+        TransactionPlan::fromPool( God->pool() ).write( policy.savePlan() );
+        zypper.out().info( str::Format(_("Transaction plan saved to '%1%'.")) % policy.savePlan() );
+      }
+      catch ( const Exception & e )
+      {
+        ZYPP_CAUGHT( e );
+        zypper.out().error( e, _("Failed to save the transaction plan.") );
+        zypper.setExitCode( ZYPPER_EXIT_ERR_ZYPP );
+        return;
+      }
+    }
 
     if ( summary.packagesToGetAndInstall()
       || summary.packagesToRemove()
@@ -873,7 +905,10 @@ void solve_and_commit ( Zypper &zypper, SolveAndCommitPolicy policy )
 	  PatchRebootRulesWatchdog guard { summary.hasViewOption( Summary::PATCH_REBOOT_RULES ) && not summary.needMachineReboot() };
 
           MIL << "Using commit policy: " << policy.zyppCommitPolicy() << endl;
-          result = God->commit( policy.zyppCommitPolicy() );
+          {
+            PhaseProfile::Scope profile( "commit" );	// download and rpm are reported by the callbacks
+            result = God->commit( policy.zyppCommitPolicy() );
+          }
           
 	  gData.show_media_progress_hack = false;
 	  gData.entered_commit = false;
@@ -50,10 +50,17 @@ struct SolveAndCommitPolicy {
   SolveAndCommitPolicy &downloadMode(DownloadMode dlMode);
   DownloadMode downloadMode() const;
 
+  /*!
+   * Save the solved transaction to this file (see \ref TransactionPlan).
+   */
+  const std::string &savePlan () const;
+  SolveAndCommitPolicy &savePlan ( std::string file_r );
+
 private:
   bool _forceCommit    = false;
   Summary::ViewOptions _summaryOptions = Summary::DEFAULT;
   ZYppCommitPolicy _zyppCommitPolicy;
+  std::string _savePlan;
 };
 
 /**
@@ -1,8 +1,15 @@
+#include <sys/stat.h>
+#include <unistd.h>	// environ
+
 #include <iostream> // for xml and table output
 #include <sstream>
 
 #include <zypp/base/LogTools.h>
 #include <zypp/ZYppFactory.h>
+#include <zypp/ZConfig.h>
+#include <zypp/Digest.h>
+#include <zypp/PathInfo.h>
+#include <zypp/target/rpm/RpmDb.h>
 #include <zypp/base/Algorithm.h>
 #include <zypp/base/Iterable.h>
 #include <zypp/PoolQuery.h>
@@ -15,6 +22,8 @@
 #include "main.h"
 #include "global-settings.h"
 #include "utils/misc.h"
+#include "utils/ResultCache.h"
+#include "utils/PatchIssueIndex.h"
 
 using namespace zypp;
 typedef std::set<PoolItem> Candidates;
@@ -439,6 +448,127 @@ namespace
 } // namespace
 ///////////////////////////////////////////////////////////////////
 
+///////////////////////////////////////////////////////////////////
+namespace
+{
+  /** Identify a file by inode, size and mtime (in ns; the rpmdb may change within a second). */
+  void statLine( std::ostream & str_r, const Pathname & path_r )
+  {
+    struct stat st;
+    str_r << path_r;
+    if ( ::stat( path_r.c_str(), &st ) == 0 )
+      str_r << " " << st.st_ino << " " << st.st_size << " " << st.st_mtim.tv_sec << "." << st.st_mtim.tv_nsec;
+    str_r << "\n";
+  }
+
+  /** \ref statLine for the files in a directory. */
+  void statDir( std::ostream & str_r, const Pathname & dir_r )
+  {
+    std::list<std::string> names;
+    filesystem::readdir( names, dir_r, false );
+    names.sort();
+    for ( const std::string & name : names )
+      statLine( str_r, dir_r / name );
+  }
+
+  /** What is asked and how the answer looks. */
+  std::string queryKey( Zypper & zypper )
+  {
+    std::ostringstream str;
+    for ( int i = 0; i < zypper.argc(); ++i )
+      str << zypper.argv()[i] << "\n";
+
+    for ( char ** env = environ; *env; ++env )
+    {
+      const std::string var( *env );
+      if ( str::startsWith( var, "ZYPP" ) || str::startsWith( var, "LANG" ) || str::startsWith( var, "LC_" )
+	|| str::startsWith( var, "COLUMNS=" ) || str::startsWith( var, "TERM=" ) )
+	str << var << "\n";
+    }
+
+    str << "termwidth " << zypper.out().termwidth()
+        << " ttyout " << zypper.config().do_ttyout
+        << " colors " << zypper.config().do_colors << "\n";
+    return str.str();
+  }
+
+  /** The state of the system the answer depends on. */
+  std::string systemFingerprint( Zypper & zypper )
+  {
+    std::stringstream str;
+    str << "arch " << ZConfig::instance().systemArchitecture() << "\n";
+
+    RepoManager & manager( zypper.repoManager() );
+    for ( const RepoInfo & repo : zypper.runtimeData().repos )
+    {
+      if ( ! repo.enabled() )
+	continue;
+      RepoStatus status( manager.metadataStatus( repo ) );
+      str << "repo " << repo.alias() << " " << repo.priority() << " " << repo.url() << " "
+          << status.checksum() << " " << Date::ValueType(status.timestamp()) << "\n";
+    }
+
+    Target_Ptr target( God->getTarget() );
+    if ( target )
+    {
+      target::rpm::RpmDb & rpmdb( target->rpmDb() );
+      statDir( str, rpmdb.root() / rpmdb.dbPath() );
+      statLine( str, Pathname::assertprefix( target->root(), ZConfig::instance().locksFile() ) );
+    }
+
+    const char * zyppconf = ::getenv( "ZYPP_CONF" );
+    statLine( str, zyppconf ? zyppconf : "/etc/zypp/zypp.conf" );
+    statDir( str, "/etc/zypp/vendors.d" );
+    statLine( str, "/etc/zypp/zypper.conf" );
+    if ( const char * home = ::getenv( "HOME" ) )
+      statLine( str, Pathname(home) / ".zypper.conf" );
+
+    return Digest::digest( Digest::sha256(), str );
+  }
+} // namespace
+///////////////////////////////////////////////////////////////////
+
+void cached_update_query( Zypper & zypper, const std::function<void()> & query_r )
+{
+  if ( ! zypper.config().queryResultCache || zypper.runningShell() )
+  {
+    query_r();
+    return;
+  }
+
+  ResultCache cache( Pathname::assertprefix( zypper.config().root_dir, ZYPPER_QUERY_CACHE_DIR ).asString() );
+  const std::string key( queryKey( zypper ) );
+  ResultCache::Entry entry;
+  entry._fingerprint = systemFingerprint( zypper );
+
+  if ( cache.lookup( key, entry._fingerprint, entry ) )
+  {
+    MIL << "Replay cached result " << cache.file( key ) << " (exit code " << entry._exitCode << ")" << endl;
+    cout << entry._output << flush;
+    zypper.setExitCode( entry._exitCode );
+    return;
+  }
+
+  {
+    ResultCache::Capture capture( cout );
+    query_r();
+    cout << flush;
+    entry._output = capture.str();
+  }
+
+  // Errors are not cached, they may be temporary.
+  entry._exitCode = zypper.exitCode();
+  if ( entry._exitCode == ZYPPER_EXIT_OK
+    || entry._exitCode == ZYPPER_EXIT_INF_UPDATE_NEEDED
+    || entry._exitCode == ZYPPER_EXIT_INF_SEC_UPDATE_NEEDED )
+  {
+    if ( cache.store( key, entry ) )
+      MIL << "Cached result " << cache.file( key ) << endl;
+    else
+      MIL << "Can't cache result in " << cache.dir() << endl;
+  }
+}
+
 void patch_check( bool updatestackOnly )
 {
   Zypper & zypper( Zypper::instance() );
@@ -856,83 +986,38 @@ void list_patches_by_issue( Zypper & zypper, bool all_r, const PatchSelector & s
                                sel_r._requestedPatchDates,
                                sel_r._requestedPatchCategories,
                                sel_r._requestedPatchSeverity );
-
+  auto acceptPatch = [&]( const PoolItem & pi_r )->bool {
+    if ( only_needed && ! patchIsApplicable( pi_r ) )
+      return false;
+    if ( ! cliMatchPatch( pi_r ) )
+    {
+      DBG << pi_r.ident() << " skipped. (not matching CLI filter)" << endl;
+      return false;
+    }
+    return true;
+  };
 
   // pass1 finding PoolItems and their matching issues (pi,itype,iid)
-  std::vector<const Issue*> pass2; // on the fly remember anyType issues for pass2
   std::map<PoolItem,std::map<std::string,std::set<std::string>>> iresult;
-  for ( const Issue & issue : sel_r._requestedIssues )
+  PoolItem lastPi;	// the matches are grouped by patch, filter each patch once
+  bool lastAccepted = false;
+  for ( const PatchIssueIndex::Ref * ref : PatchIssueIndex().matching( sel_r._requestedIssues ) )
   {
-    PoolQuery q;
-    q.setMatchSubstring();
-    q.setCaseSensitive( false );
-    q.addKind( ResKind::patch );
-    // PoolQuery ORs attributes but we need AND.
-    // Post processing the match must assert correct type of specific IDs!
-    if ( issue.specificType() && issue.anyId() )
-    { q.addAttribute(sat::SolvAttr::updateReferenceType, issue.type() ); }
-    else
+    if ( ref->_pi != lastPi )
     {
-      q.addAttribute( sat::SolvAttr::updateReferenceId, issue.id() );
-      if ( issue.anyType() && issue.specificId() ) 				// remember for pass2
-      {
-	q.addAttribute( sat::SolvAttr::updateReferenceType, issue.id() );	// bnc#941309: let '--issue=bugzilla' also match the type
-	pass2.push_back( &issue );
-      }
-    }
-
-    for_( it, q.begin(), q.end() )
-    {
-      PoolItem pi { *it };
-
-      if ( only_needed && ! patchIsApplicable( pi ) )
-	continue;
-
-      if ( ! cliMatchPatch( pi ) )
-      {
-	DBG << pi.ident() << " skipped. (not matching CLI filter)" << endl;
-	continue;
-      }
-
-      for_( d, it.matchesBegin(), it.matchesEnd() )
-      {
-	std::string itype { d->subFind( sat::SolvAttr::updateReferenceType ).asString() };
-	if ( issue.specificType() && itype != issue.type() )
-	  continue;	// assert correct type of specific IDs
-	// remember....
-	iresult[std::move(pi)][std::move(itype)].insert( d->subFind( sat::SolvAttr::updateReferenceId ).asString() );
-      }
+      lastPi = ref->_pi;
+      lastAccepted = acceptPatch( lastPi );
     }
+    if ( lastAccepted )
+      iresult[ref->_pi][ref->_type].insert( ref->_id );	// remember....
   }
 
   //pass2 (summary/description)
-  std::vector<PoolItem> dresult;	// query will assert unique entries
-  for ( const Issue * _issue : pass2 )
+  std::vector<PoolItem> dresult;
+  for ( const PoolItem & pi : PatchIssueIndex::describing( sel_r._requestedIssues ) )
   {
-    const Issue & issue { *_issue };
-    PoolQuery q;
-    q.setMatchSubstring();
-    q.setCaseSensitive( false );
-    q.addKind( ResKind::patch );
-    q.addAttribute(sat::SolvAttr::summary, issue.id() );
-    q.addAttribute(sat::SolvAttr::description, issue.id() );
-
-    for_( it, q.begin(), q.end() )
-    {
-      PoolItem pi { *it };
-
-      if ( only_needed && ! patchIsApplicable( pi ) )
-	continue;
-
-      if ( ! cliMatchPatch( pi ) )
-      {
-	DBG << pi.ident() << " skipped. (not matching CLI filter)" << endl;
-	continue;
-      }
-
-      if ( ! iresult.count( pi ) )
-      { dresult.push_back( pi ); }
-    }
+    if ( ! iresult.count( pi ) && acceptPatch( pi ) )
+    { dresult.push_back( pi ); }
   }
 
   ///////////////////////////////////////////////////////////////////
@@ -999,47 +1084,28 @@ void list_patches_by_issue( Zypper & zypper, bool all_r, const PatchSelector & s
 
 void mark_updates_by_issue( Zypper & zypper, const std::set<Issue> &issues, SolverRequester::Options srOpts )
 {
+  PatchIssueIndex index;
   for ( const Issue & issue : issues )
   {
-    PoolQuery q;
-    q.setMatchExact();
-    q.setCaseSensitive( false );
-    q.addKind( ResKind::patch );
-    // PoolQuery ORs attributes but we need AND.
-    // Post processing the match must assert correct type of specific IDs!
-    if ( issue.specificType() && issue.anyId() )
-    { q.addAttribute(sat::SolvAttr::updateReferenceType, issue.type() ); }
-    else
-    { q.addAttribute( sat::SolvAttr::updateReferenceId, issue.id() ); }
-
     SolverRequester sr( srOpts );
     bool found = false;
 
-    for_( it, q.begin(), q.end() )
+    for ( const PatchIssueIndex::Ref * ref : index.naming( issue ) )
     {
-      PoolItem pi( *it );
-      Patch::constPtr patch = asKind<Patch>(pi);
+      const PoolItem & pi { ref->_pi };
 
       if ( !pi.isBroken() ) // not needed
 	continue;
 
       // CliMatchPatch not needed, it's fed into srOpts!
 
-      DBG << "got: " << *it << endl;
-
-      for_( d, it.matchesBegin(), it.matchesEnd() )
-      {
-	const std::string & itype = d->subFind( sat::SolvAttr::updateReferenceType ).asString();
-
-	if ( issue.specificType() && itype != issue.type() )
-	  continue;	// assert correct type of specific IDs
+      DBG << "got: " << pi << endl;
 
-	if ( sr.installPatch( pi ) )
-	  found = true;
-	else
-	  DBG << str::form("fix for %s issue number %s was not marked.",
-			   issue.type().c_str(), issue.id().c_str() );
-      }
+      if ( sr.installPatch( pi ) )
+	found = true;
+      else
+	DBG << str::form("fix for %s issue number %s was not marked.",
+			 issue.type().c_str(), issue.id().c_str() );
     }
 
     sr.printFeedback( zypper.out() );
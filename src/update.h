@@ -1,6 +1,8 @@
 #ifndef ZYPPER_SRC_UPDATE_H
 #define ZYPPER_SRC_UPDATE_H
 
+#include <functional>
+
 #include <zypp/PoolItem.h>
 
 #include "Zypper.h"
@@ -16,6 +18,21 @@ struct PatchSelector {
   std::vector<zypp::Date> _requestedPatchDates;
 };
 
+/**
+ * Run the read-only query \a query_r (lu, lp, pchk) unless its output is
+ * cached for the current state of the system. \a query_r is expected to
+ * load the resolvables and print the result; it is skipped if the result
+ * can be replayed.
+ *
+ * The state covers the command line, locale and terminal settings, the
+ * metadata of the enabled repos, the rpm database, the locks and the
+ * zypp/zypper configuration files. So it must be called after the target
+ * and the repos are initialized (and maybe refreshed).
+ *
+ * Disabled by zypper.conf: main.queryResultCache.
+ */
+void cached_update_query( Zypper & zypper, const std::function<void()> & query_r );
+
 /**
  * Are there applicable patches?
  */
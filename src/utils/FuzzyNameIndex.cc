@@ -0,0 +1,120 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+#include <algorithm>
+
+#include "utils/FuzzyNameIndex.h"
+
+namespace
+{
+  inline char fold( char ch_r )
+  { return( ch_r < 'A' || ch_r > 'Z' ? ch_r : ch_r + ( 'a' - 'A' ) ); }
+}
+
+void FuzzyNameIndex::add( boost::string_ref name_r )
+{
+  _names.push_back( Name { uint32_t(_arena.size()), uint32_t(name_r.size()) } );
+  _arena.append( name_r.data(), name_r.size() );
+  _sorted = false;
+}
+
+void FuzzyNameIndex::sort() const
+{
+  std::stable_sort( _names.begin(), _names.end(), []( const Name & lhs, const Name & rhs ) {
+    return lhs._size < rhs._size;
+  } );
+  _sorted = true;
+}
+
+unsigned FuzzyNameIndex::distance( boost::string_ref lhs_r, boost::string_ref rhs_r, unsigned max_r )
+{
+  if ( lhs_r.size() > rhs_r.size() )
+    std::swap( lhs_r, rhs_r );
+  const size_t lsize = lhs_r.size();
+  const size_t rsize = rhs_r.size();
+  if ( rsize - lsize > max_r )
+    return max_r + 1;
+
+  // Only cells within max_r of the diagonal may lead to a result <= max_r;
+  // cells outside the band are treated as max_r+1.
+  const unsigned outside = max_r + 1;
+  std::vector<unsigned> prev( lsize + 1 ), curr( lsize + 1 );
+  for ( size_t i = 0; i <= lsize; ++i )
+    prev[i] = std::min<size_t>( i, outside );
+
+  for ( size_t j = 1; j <= rsize; ++j )
+  {
+    size_t from = j > max_r ? j - max_r : 1;
+    size_t to   = std::min<size_t>( lsize, j + max_r );
+    curr[0] = std::min<size_t>( j, outside );
+    if ( from > 1 )
+      curr[from-1] = outside;
+    unsigned rowMin = curr[0];
+
+    const char rch = fold( rhs_r[j-1] );
+    for ( size_t i = from; i <= to; ++i )
+    {
+      unsigned cost = ( fold( lhs_r[i-1] ) == rch ? 0 : 1 );
+      unsigned val = std::min( { prev[i-1] + cost, prev[i] + 1, curr[i-1] + 1 } );
+      curr[i] = std::min( val, outside );
+      rowMin = std::min( rowMin, curr[i] );
+    }
+    if ( to < lsize )
+      curr[to+1] = outside;
+
+    if ( rowMin > max_r )
+      return outside;	// no way back into range
+    std::swap( prev, curr );
+  }
+  return std::min( prev[lsize], outside );
+}
+
+std::vector<std::string> FuzzyNameIndex::lookup( boost::string_ref name_r, unsigned maxDistance_r, unsigned maxResults_r ) const
+{
+  std::vector<std::string> ret;
+  if ( _names.empty() || ! maxResults_r )
+    return ret;
+  if ( ! _sorted )
+    sort();
+
+  // visit names of length [size-max,size+max] only
+  size_t minSize = name_r.size() > maxDistance_r ? name_r.size() - maxDistance_r : 0;
+  size_t maxSize = name_r.size() + maxDistance_r;
+  auto it = std::lower_bound( _names.begin(), _names.end(), minSize, []( const Name & lhs, size_t rhs ) {
+    return lhs._size < rhs;
+  } );
+
+  std::vector<std::pair<unsigned,boost::string_ref>> found;
+  unsigned limit = maxDistance_r;
+  for ( ; it != _names.end() && it->_size <= maxSize; ++it )
+  {
+    boost::string_ref candidate { name( *it ) };
+    if ( candidate == name_r )
+      continue;
+    unsigned dist = distance( name_r, candidate, limit );
+    if ( dist > limit )
+      continue;
+
+    found.push_back( { dist, candidate } );
+    if ( found.size() >= 4 * maxResults_r )
+    {
+      // keep the best ones only and tighten the limit
+      std::sort( found.begin(), found.end() );
+      found.resize( maxResults_r );
+      limit = found.back().first;
+    }
+  }
+
+  std::sort( found.begin(), found.end() );
+  found.erase( std::unique( found.begin(), found.end() ), found.end() );
+  if ( found.size() > maxResults_r )
+    found.resize( maxResults_r );
+
+  ret.reserve( found.size() );
+  for ( const auto & el : found )
+    ret.push_back( el.second.to_string() );
+  return ret;
+}
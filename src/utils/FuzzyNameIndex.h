@@ -0,0 +1,67 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+#ifndef ZYPPER_UTILS_FUZZYNAMEINDEX_H
+#define ZYPPER_UTILS_FUZZYNAMEINDEX_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include <boost/utility/string_ref.hpp>
+
+///////////////////////////////////////////////////////////////////
+/// \class FuzzyNameIndex
+/// \brief Compact name index for bounded edit-distance ("did you mean") lookups.
+///
+/// All names are stored in a single arena, ordered by length. A lookup
+/// only visits names whose length is within \c maxDistance_r of the
+/// query and computes a banded, early terminating Levenshtein distance
+/// (ASCII case-insensitive) for them.
+///////////////////////////////////////////////////////////////////
+class FuzzyNameIndex
+{
+public:
+  /** Add a name to the index. */
+  void add( boost::string_ref name_r );
+
+  /** Number of names in the index. */
+  size_t size() const
+  { return _names.size(); }
+
+  bool empty() const
+  { return _names.empty(); }
+
+  /** The (at most \a maxResults_r) names closest to \a name_r, but not more than \a maxDistance_r edits away.
+   * Names are ordered by distance, then alphabetically. A name equal to \a name_r is not reported.
+   */
+  std::vector<std::string> lookup( boost::string_ref name_r, unsigned maxDistance_r, unsigned maxResults_r = 3 ) const;
+
+  /** A reasonable max. distance for a typo in a name of length \a size_r. */
+  static unsigned defaultMaxDistance( size_t size_r )
+  { return( size_r <= 4 ? 1 : size_r <= 10 ? 2 : 3 ); }
+
+  /** ASCII case-insensitive Levenshtein distance of \a lhs_r and \a rhs_r, or \a max_r+1 if it exceeds \a max_r. */
+  static unsigned distance( boost::string_ref lhs_r, boost::string_ref rhs_r, unsigned max_r );
+
+private:
+  struct Name
+  {
+    uint32_t _offset;
+    uint32_t _size;
+  };
+
+  boost::string_ref name( const Name & name_r ) const
+  { return boost::string_ref( _arena.data() + name_r._offset, name_r._size ); }
+
+  void sort() const;
+
+  std::string _arena;
+  mutable std::vector<Name> _names;
+  mutable bool _sorted = true;
+};
+
+#endif // ZYPPER_UTILS_FUZZYNAMEINDEX_H
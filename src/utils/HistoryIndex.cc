@@ -0,0 +1,147 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <sstream>
+
+#include "HistoryIndex.h"
+
+namespace
+{
+  const char * magic = "zypper-history-index 1";
+
+  inline std::string entryKey( const HistoryIndex::Entry & entry_r )
+  { return entry_r._name + " " + entry_r._edition + " " + entry_r._arch; }
+
+  /** mkdir of the parent directory, which usually exists. */
+  void assertParentDir( const std::string & file_r )
+  {
+    std::string::size_type pos = file_r.rfind( '/' );
+    if ( pos != std::string::npos && pos != 0 )
+      ::mkdir( file_r.substr( 0, pos ).c_str(), 0755 );
+  }
+} // namespace
+
+HistoryIndex::HistoryIndex( std::string file_r )
+: _file( std::move(file_r) )
+{
+  std::ifstream str( _file.c_str() );
+  std::string line;
+  if ( ! std::getline( str, line ) || line != magic )
+    return;
+
+  if ( ! std::getline( str, _log )
+    || ! ( str >> _inode >> _offset ) || str.get() != '\n'
+    || ! std::getline( str, _lastLine ) )
+  {
+    clear();
+    return;
+  }
+
+  while ( std::getline( str, line ) )
+  {
+    Entry entry;
+    std::istringstream fields( line );
+    if ( ! ( fields >> entry._date ) || fields.get() != '\t'
+      || ! std::getline( fields, entry._state, '\t' )
+      || ! std::getline( fields, entry._name, '\t' )
+      || ! std::getline( fields, entry._edition, '\t' )
+      || ! std::getline( fields, entry._arch ) )
+    {
+      clear();	// a broken index is rebuilt
+      return;
+    }
+    remember( std::move(entry) );
+  }
+}
+
+void HistoryIndex::clear()
+{
+  _log.clear();
+  _inode = 0;
+  _offset = 0;
+  _lastLine.clear();
+  _entries.clear();
+}
+
+bool HistoryIndex::update( const std::string & log_r, const LineParser & parse_r )
+{
+  struct stat st;
+  if ( ::stat( log_r.c_str(), &st ) != 0 )
+    return false;
+
+  std::ifstream str( log_r.c_str() );
+  if ( ! str )
+    return false;
+
+  if ( log_r != _log || st.st_ino != _inode || st.st_size < _offset )
+    clear();
+  else if ( _offset )
+  {
+    // Same file, but it may have been truncated and rewritten in place.
+    long long begin = _offset - static_cast<long long>( _lastLine.size() ) - 1;
+    std::string check( _lastLine.size() + 1, '\0' );
+    if ( begin < 0
+      || ! str.seekg( begin )
+      || ! str.read( &check[0], check.size() )
+      || check != _lastLine + "\n" )
+    {
+      clear();
+      str.clear();
+      str.seekg( 0 );
+    }
+  }
+  _log = log_r;
+  _inode = st.st_ino;
+
+  std::string line;
+  while ( std::getline( str, line ) )
+  {
+    if ( str.eof() )
+      break;	// no trailing newline: still being written
+    _offset += line.size() + 1;
+    _lastLine = line;
+    parse_r( line );
+  }
+  return true;
+}
+
+void HistoryIndex::remember( Entry entry_r )
+{
+  Entry & entry( _entries[entryKey( entry_r )] );
+  if ( entry._name.empty() || entry_r._date > entry._date )
+    entry = std::move(entry_r);
+}
+
+bool HistoryIndex::save() const
+{
+  assertParentDir( _file );
+
+  std::string tmp( _file + "." + std::to_string( ::getpid() ) );
+  {
+    std::ofstream str( tmp.c_str(), std::ios_base::out | std::ios_base::trunc );
+    str << magic << "\n" << _log << "\n" << _inode << " " << _offset << "\n" << _lastLine << "\n";
+    for ( const auto & el : _entries )
+    {
+      const Entry & entry( el.second );
+      str << entry._date << "\t" << entry._state << "\t" << entry._name << "\t" << entry._edition << "\t" << entry._arch << "\n";
+    }
+    if ( ! str.flush() )
+    {
+      ::unlink( tmp.c_str() );
+      return false;
+    }
+  }
+  if ( ::rename( tmp.c_str(), _file.c_str() ) != 0 )
+  {
+    ::unlink( tmp.c_str() );
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,82 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+#ifndef ZYPPER_UTILS_HISTORYINDEX_H
+#define ZYPPER_UTILS_HISTORYINDEX_H
+
+#include <functional>
+#include <map>
+#include <string>
+
+///////////////////////////////////////////////////////////////////
+/// \class HistoryIndex
+/// \brief The last patch status changes found in the history log,
+/// remembered across zypper runs.
+///
+/// The history log grows forever and parsing it in full takes long on
+/// old systems. The index remembers the entries found so far and up to
+/// which byte the log was parsed, so \ref update needs to look at the
+/// lines appended since the last run only.
+///
+/// The log is parsed from the beginning if it is a different file
+/// (other path or inode, e.g. after logrotate) or if it no longer
+/// matches what was parsed before (it shrank or the last parsed line
+/// changed, e.g. truncated in place).
+///////////////////////////////////////////////////////////////////
+class HistoryIndex
+{
+public:
+  struct Entry
+  {
+    std::string _name;
+    std::string _edition;
+    std::string _arch;
+    long long _date = 0;	///< seconds since the epoch
+    std::string _state;		///< the new state as written to the log
+  };
+
+  using LineParser = std::function<void( const std::string & line_r )>;
+
+public:
+  /** Ctor; the index is read from \a file_r if it exists. */
+  explicit HistoryIndex( std::string file_r );
+
+  /** Pass the lines of \a log_r not yet parsed to \a parse_r.
+   * Only complete lines are passed, a line still being written is
+   * parsed next time. \a parse_r is expected to \ref remember the
+   * entries it finds.
+   * \return \c false if \a log_r can't be read.
+   */
+  bool update( const std::string & log_r, const LineParser & parse_r );
+
+  /** Remember an entry, unless there is a later one for the same N/V/A. */
+  void remember( Entry entry_r );
+
+  /** Write the index.
+   * \return \c false if it can't be written (e.g. not root).
+   */
+  bool save() const;
+
+  /** The latest entry per N/V/A. */
+  const std::map<std::string,Entry> & entries() const
+  { return _entries; }
+
+  /** Offset up to which the log was parsed. */
+  long long offset() const
+  { return _offset; }
+
+private:
+  void clear();
+
+  std::string _file;
+  std::string _log;		///< the log the index was built from
+  unsigned long long _inode = 0;
+  long long _offset = 0;
+  std::string _lastLine;	///< the line ending at \ref _offset
+  std::map<std::string,Entry> _entries;
+};
+
+#endif // ZYPPER_UTILS_HISTORYINDEX_H
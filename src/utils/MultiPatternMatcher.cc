@@ -0,0 +1,124 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+#include <deque>
+
+#include "utils/MultiPatternMatcher.h"
+
+namespace
+{
+  constexpr uint32_t noState = uint32_t(-1);
+  constexpr unsigned alphabet = 256;
+}
+
+MultiPatternMatcher::MultiPatternMatcher( Mode mode_r, bool caseSensitive_r )
+: _mode( mode_r )
+, _caseSensitive( caseSensitive_r )
+, _matchAll( false )
+, _compiled( false )
+{}
+
+void MultiPatternMatcher::add( std::string pattern_r )
+{
+  for ( char & ch : pattern_r )
+    ch = fold( ch );
+
+  if ( _mode == Mode::Exact )
+    _exact.insert( pattern_r );
+  else if ( pattern_r.empty() )
+    _matchAll = true;
+
+  _patterns.push_back( std::move(pattern_r) );
+  _compiled = false;
+}
+
+void MultiPatternMatcher::compile() const
+{
+  _delta.assign( alphabet, noState );
+  _accept.assign( 1, false );
+
+  // build the trie
+  for ( const std::string & pattern : _patterns )
+  {
+    uint32_t state = 0;
+    for ( unsigned char ch : pattern )
+    {
+      uint32_t & next( _delta[state*alphabet+ch] );
+      if ( next == noState )
+      {
+	next = _accept.size();
+	_accept.push_back( false );
+	_delta.resize( _delta.size() + alphabet, noState );
+      }
+      state = _delta[state*alphabet+ch];	// _delta may have been reallocated
+    }
+    _accept[state] = true;
+  }
+
+  // breadth first: complete the transitions via the failure links
+  std::vector<uint32_t> failure( _accept.size(), 0 );
+  std::deque<uint32_t> todo;
+  for ( unsigned ch = 0; ch < alphabet; ++ch )
+  {
+    uint32_t & next( _delta[ch] );
+    if ( next == noState )
+      next = 0;
+    else
+      todo.push_back( next );
+  }
+  while ( ! todo.empty() )
+  {
+    uint32_t state = todo.front();
+    todo.pop_front();
+    if ( _accept[failure[state]] )
+      _accept[state] = true;
+
+    for ( unsigned ch = 0; ch < alphabet; ++ch )
+    {
+      uint32_t & next( _delta[state*alphabet+ch] );
+      uint32_t fnext = _delta[failure[state]*alphabet+ch];
+      if ( next == noState )
+	next = fnext;
+      else
+      {
+	failure[next] = fnext;
+	todo.push_back( next );
+      }
+    }
+  }
+  _compiled = true;
+}
+
+bool MultiPatternMatcher::matches( boost::string_ref text_r ) const
+{
+  if ( _patterns.empty() )
+    return false;
+
+  if ( _mode == Mode::Exact )
+  {
+    if ( _caseSensitive )
+      return _exact.count( std::string( text_r.data(), text_r.size() ) );
+    std::string folded;
+    folded.reserve( text_r.size() );
+    for ( char ch : text_r )
+      folded += fold( ch );
+    return _exact.count( folded );
+  }
+
+  if ( _matchAll )
+    return true;
+  if ( ! _compiled )
+    compile();
+
+  uint32_t state = 0;
+  for ( unsigned char ch : text_r )
+  {
+    state = _delta[state*alphabet+fold( ch )];
+    if ( _accept[state] )
+      return true;
+  }
+  return false;
+}
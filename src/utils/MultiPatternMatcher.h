@@ -0,0 +1,82 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+#ifndef ZYPPER_UTILS_MULTIPATTERNMATCHER_H
+#define ZYPPER_UTILS_MULTIPATTERNMATCHER_H
+
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include <cstdint>
+
+#include <boost/utility/string_ref.hpp>
+
+///////////////////////////////////////////////////////////////////
+/// \class MultiPatternMatcher
+/// \brief Match a string against many plain patterns in a single pass.
+///
+/// Substring patterns are compiled into an Aho-Corasick automaton, so
+/// a text is scanned once no matter how many patterns were added. Exact
+/// patterns are kept in a hash set. Unless \c caseSensitive_r, patterns
+/// and texts are compared ASCII case-insensitive (like libsolv does).
+///
+/// \code
+///   MultiPatternMatcher m;
+///   m.add( "zypp" );
+///   m.add( "yast" );
+///   m.matches( "libzypp-devel" ); // true
+/// \endcode
+///////////////////////////////////////////////////////////////////
+class MultiPatternMatcher
+{
+public:
+  enum class Mode
+  {
+    Substring,	///< pattern matches anywhere in the text
+    Exact	///< pattern must match the whole text
+  };
+
+public:
+  MultiPatternMatcher( Mode mode_r = Mode::Substring, bool caseSensitive_r = false );
+
+  Mode mode() const
+  { return _mode; }
+
+  bool caseSensitive() const
+  { return _caseSensitive; }
+
+  /** Add another pattern (invalidates a compiled automaton). */
+  void add( std::string pattern_r );
+
+  /** Whether no pattern was added. */
+  bool empty() const
+  { return _patterns.empty(); }
+
+  /** Number of patterns added. */
+  size_t size() const
+  { return _patterns.size(); }
+
+  /** Whether \a text_r matches any of the patterns. */
+  bool matches( boost::string_ref text_r ) const;
+
+private:
+  void compile() const;
+  unsigned char fold( unsigned char ch_r ) const
+  { return( _caseSensitive || ch_r < 'A' || ch_r > 'Z' ? ch_r : ch_r + ( 'a' - 'A' ) ); }
+
+  Mode _mode;
+  bool _caseSensitive;
+  bool _matchAll;				///< an empty substring pattern matches everything
+  std::vector<std::string> _patterns;		///< folded patterns as added
+  std::unordered_set<std::string> _exact;	///< Mode::Exact lookup
+
+  // Aho-Corasick DFA: _delta[state*256+ch] -> state; _accept[state]
+  mutable bool _compiled;
+  mutable std::vector<uint32_t> _delta;
+  mutable std::vector<bool> _accept;
+};
+
+#endif // ZYPPER_UTILS_MULTIPATTERNMATCHER_H
@@ -0,0 +1,68 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+#ifndef ZYPPER_UTILS_MULTIPATTERNQUERY_H
+#define ZYPPER_UTILS_MULTIPATTERNQUERY_H
+
+#include <string>
+#include <unordered_map>
+
+#include <zypp/sat/Solvable.h>
+#include <zypp/sat/SolvAttr.h>
+#include <zypp/Edition.h>
+
+#include "utils/MultiPatternMatcher.h"
+
+///////////////////////////////////////////////////////////////////
+/// \class MultiPatternQuery
+/// \brief Single pass alternative to a PoolQuery with many plain search strings.
+///
+/// A PoolQuery matches each solvable against every search string and
+/// attribute separately. If all search strings are plain names (no glob,
+/// regex, edition, arch or kind prefix), we collect them in a
+/// \ref MultiPatternMatcher and test each attribute string once.
+/// The "N-V" and "N-V-R" interpretation of an argument is kept in a
+/// name index.
+///
+/// Like the PoolQuery, names are matched without the kind prefix of
+/// the ident ("pattern:base" is matched as "base"). Filtering the kinds
+/// is up to the query providing the solvables.
+///////////////////////////////////////////////////////////////////
+struct MultiPatternQuery
+{
+  MultiPatternQuery( MultiPatternMatcher::Mode mode_r, bool caseSensitive_r )
+  : _matcher( mode_r, caseSensitive_r )
+  {}
+
+  void addEdition( std::string name_r, zypp::Edition edition_r )
+  { _editions.insert( std::make_pair( std::move(name_r), std::move(edition_r) ) ); }
+
+  bool operator()( const zypp::sat::Solvable & solv_r ) const
+  {
+    const std::string & name { solv_r.name() };
+    if ( _matcher.matches( name ) )
+      return true;
+
+    if ( ! _editions.empty() )
+    {
+      auto range = _editions.equal_range( name );
+      for ( auto it = range.first; it != range.second; ++it )
+	if ( zypp::Edition::match( solv_r.edition(), it->second ) == 0 )
+	  return true;
+    }
+
+    if ( _searchDesc )
+      return _matcher.matches( solv_r.lookupStrAttribute( zypp::sat::SolvAttr::summary ) )
+	  || _matcher.matches( solv_r.lookupStrAttribute( zypp::sat::SolvAttr::description ) );
+    return false;
+  }
+
+  MultiPatternMatcher _matcher;
+  std::unordered_multimap<std::string, zypp::Edition> _editions;
+  bool _searchDesc = false;
+};
+
+#endif // ZYPPER_UTILS_MULTIPATTERNQUERY_H
@@ -0,0 +1,121 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+#include <algorithm>
+#include <map>
+
+#include <zypp/base/Easy.h>
+#include <zypp/base/Logger.h>
+#include <zypp/base/String.h>
+#include <zypp/ResPool.h>
+#include <zypp/Patch.h>
+
+#include "utils/MultiPatternMatcher.h"
+#include "utils/PatchIssueIndex.h"
+
+using namespace zypp;
+
+PatchIssueIndex::PatchIssueIndex()
+{
+  for ( const PoolItem & pi : ResPool::instance().byKind<Patch>() )
+  {
+    Patch::constPtr patch { asKind<Patch>( pi ) };
+    for_( it, patch->referencesBegin(), patch->referencesEnd() )
+    {
+      _byId[str::toLower( it.id() )].push_back( _refs.size() );
+      _byType[it.type()].push_back( _refs.size() );
+      _refs.push_back( { pi, it.type(), it.id() } );
+    }
+  }
+  DBG << "Indexed " << _refs.size() << " patch issue references" << endl;
+}
+
+std::vector<const PatchIssueIndex::Ref *> PatchIssueIndex::byId( const std::string & id_r ) const
+{ return lookup( _byId, str::toLower( id_r ) ); }
+
+std::vector<const PatchIssueIndex::Ref *> PatchIssueIndex::byType( const std::string & type_r ) const
+{ return lookup( _byType, type_r ); }
+
+std::vector<const PatchIssueIndex::Ref *> PatchIssueIndex::naming( const Issue & issue_r ) const
+{
+  if ( issue_r.anyId() )
+    return byType( issue_r.type() );
+
+  std::vector<const Ref *> ret { byId( issue_r.id() ) };
+  if ( issue_r.specificType() )
+  {
+    ret.erase( std::remove_if( ret.begin(), ret.end(), [&issue_r]( const Ref * ref_r ) {
+      return ref_r->_type != issue_r.type();	// assert correct type of specific IDs
+    } ), ret.end() );
+  }
+  return ret;
+}
+
+std::vector<const PatchIssueIndex::Ref *> PatchIssueIndex::matching( const std::set<Issue> & issues_r ) const
+{
+  std::set<std::string> anyIdTypes;				// type: any id
+  std::map<std::string,MultiPatternMatcher> byTypeMatcher;	// type: matches id
+  MultiPatternMatcher anyTypeMatcher;				// matches id or type
+  for ( const Issue & issue : issues_r )
+  {
+    if ( issue.specificType() && issue.anyId() )
+      anyIdTypes.insert( issue.type() );
+    else if ( issue.specificType() )
+      byTypeMatcher[issue.type()].add( issue.id() );
+    else
+      anyTypeMatcher.add( issue.id() );
+  }
+
+  std::vector<const Ref *> ret;
+  for ( const Ref & ref : _refs )
+  {
+    bool match = anyIdTypes.count( ref._type );
+    if ( ! match )
+    {
+      auto it { byTypeMatcher.find( ref._type ) };
+      match = ( it != byTypeMatcher.end() && it->second.matches( ref._id ) );
+    }
+    if ( ! match )
+      match = ( anyTypeMatcher.matches( ref._id ) || anyTypeMatcher.matches( ref._type ) );
+
+    if ( match )
+      ret.push_back( &ref );
+  }
+  return ret;
+}
+
+std::vector<PoolItem> PatchIssueIndex::describing( const std::set<Issue> & issues_r )
+{
+  std::vector<PoolItem> ret;
+  MultiPatternMatcher descrMatcher;
+  for ( const Issue & issue : issues_r )
+  {
+    if ( issue.anyType() && issue.specificId() )
+      descrMatcher.add( issue.id() );
+  }
+  if ( descrMatcher.empty() )
+    return ret;
+
+  for ( const PoolItem & pi : ResPool::instance().byKind<Patch>() )
+  {
+    const sat::Solvable & solv { pi.satSolvable() };
+    if ( descrMatcher.matches( solv.lookupStrAttribute( sat::SolvAttr::summary ) )
+      || descrMatcher.matches( solv.lookupStrAttribute( sat::SolvAttr::description ) ) )
+      ret.push_back( pi );
+  }
+  return ret;
+}
+
+std::vector<const PatchIssueIndex::Ref *> PatchIssueIndex::lookup( const IndexMap & map_r, const std::string & key_r ) const
+{
+  std::vector<const Ref *> ret;
+  if ( auto it { map_r.find( key_r ) }; it != map_r.end() )
+  {
+    for ( size_t idx : it->second )
+      ret.push_back( &_refs[idx] );
+  }
+  return ret;
+}
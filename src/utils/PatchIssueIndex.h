@@ -0,0 +1,88 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+#ifndef ZYPPER_UTILS_PATCHISSUEINDEX_H
+#define ZYPPER_UTILS_PATCHISSUEINDEX_H
+
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <zypp/PoolItem.h>
+
+#include "issue.h"
+
+///////////////////////////////////////////////////////////////////
+/// \class PatchIssueIndex
+/// \brief The issue references of all patches, collected in a single pool pass.
+///
+/// Security tools pass hundreds of --cve at once. A PoolQuery per issue
+/// scans all patches once per issue; the index is built once and looks up
+/// issue ids in a hash map. Substring matches of many issues are done in
+/// one pass over the references, using a \ref MultiPatternMatcher.
+///
+/// The matching is the same as with the former PoolQueries: ids are
+/// compared ASCII case-insensitive, and a reference matching an issue of
+/// a specific type must have exactly that type. This also holds for
+/// issues of a specific type but no id: the query matched the type as
+/// case-insensitive substring, but the matches were then checked for
+/// the exact type.
+///////////////////////////////////////////////////////////////////
+class PatchIssueIndex
+{
+public:
+  struct Ref
+  {
+    zypp::PoolItem _pi;
+    std::string _type;
+    std::string _id;
+  };
+
+public:
+  /** Ctor; collects the references of all patches in the pool. */
+  PatchIssueIndex();
+
+  /** All references, grouped by patch. */
+  const std::vector<Ref> & refs() const
+  { return _refs; }
+
+  /** The references with id \a id_r (case insensitive). */
+  std::vector<const Ref *> byId( const std::string & id_r ) const;
+
+  /** The references of type \a type_r. */
+  std::vector<const Ref *> byType( const std::string & type_r ) const;
+
+  /** The references naming \a issue_r ('patch --bugzilla/--cve').
+   * The id must match exactly (case insensitive), a specific type too.
+   * An issue without id matches all references of its type.
+   */
+  std::vector<const Ref *> naming( const Issue & issue_r ) const;
+
+  /** The references matching any of \a issues_r ('list-patches --bugzilla/--cve/--issue'),
+   * in the order of \ref refs.
+   * The id is matched as case insensitive substring, a specific type exactly.
+   * An issue without type also matches a reference whose type contains the
+   * id (bnc#941309: '--issue=bugzilla' lists all bugzilla references).
+   */
+  std::vector<const Ref *> matching( const std::set<Issue> & issues_r ) const;
+
+  /** The patches whose summary or description contains the id of one of the
+   * \a issues_r without type (case insensitive), in pool order.
+   */
+  static std::vector<zypp::PoolItem> describing( const std::set<Issue> & issues_r );
+
+private:
+  using IndexMap = std::unordered_map<std::string,std::vector<size_t>>;
+
+  std::vector<const Ref *> lookup( const IndexMap & map_r, const std::string & key_r ) const;
+
+  std::vector<Ref> _refs;
+  IndexMap _byId;	///< lowercased id to _refs
+  IndexMap _byType;	///< type to _refs
+};
+
+#endif // ZYPPER_UTILS_PATCHISSUEINDEX_H
@@ -0,0 +1,137 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <fstream>
+
+#include "PhaseProfile.h"
+
+namespace
+{
+  inline std::chrono::microseconds toMicroseconds( const struct timeval & tv_r )
+  { return std::chrono::seconds( tv_r.tv_sec ) + std::chrono::microseconds( tv_r.tv_usec ); }
+
+  /** Storage I/O of this process; the values stay -1 if /proc/self/io is not readable. */
+  void readProcIo( long long & read_r, long long & written_r )
+  {
+    std::ifstream io( "/proc/self/io" );
+    std::string key;
+    long long val;
+    while ( io >> key >> val )
+    {
+      if ( key == "read_bytes:" )
+	read_r = val;
+      else if ( key == "write_bytes:" )
+	written_r = val;
+    }
+  }
+
+  /** Difference of two values which may be unknown (-1). */
+  inline long long knownDelta( long long start_r, long long end_r )
+  { return( start_r < 0 || end_r < 0 ? -1 : end_r - start_r ); }
+} // namespace
+
+PhaseProfile::Sample PhaseProfile::Sample::now()
+{
+  Sample ret;
+  ret._wall = Clock::now();
+
+  struct rusage self;
+  struct rusage children;
+  if ( ::getrusage( RUSAGE_SELF, &self ) == 0 && ::getrusage( RUSAGE_CHILDREN, &children ) == 0 )
+  {
+    ret._cpu = toMicroseconds( self.ru_utime ) + toMicroseconds( self.ru_stime )
+	     + toMicroseconds( children.ru_utime ) + toMicroseconds( children.ru_stime );
+    ret._maxrss = self.ru_maxrss;
+  }
+  readProcIo( ret._read, ret._written );
+  return ret;
+}
+
+PhaseProfile & PhaseProfile::instance()
+{
+  static PhaseProfile _instance;
+  return _instance;
+}
+
+void PhaseProfile::start( const std::string & name_r, const Sample & now_r )
+{
+  std::lock_guard<std::mutex> lock( _mutex );
+  auto it = std::find_if( _phases.begin(), _phases.end(), [&name_r]( const Phase & phase_r ) {
+    return phase_r._name == name_r;
+  } );
+  if ( it == _phases.end() )
+  {
+    Phase phase;
+    phase._name = name_r;
+    phase._depth = std::count_if( _phases.begin(), _phases.end(), []( const Phase & phase_r ) {
+      return phase_r._active;
+    } );
+    it = _phases.insert( _phases.end(), std::move(phase) );
+  }
+
+  if ( it->_active++ )
+    return;	// nested
+  ++it->_count;
+  it->_start = now_r;
+}
+
+void PhaseProfile::stop( const std::string & name_r, const Sample & now_r )
+{
+  std::lock_guard<std::mutex> lock( _mutex );
+  for ( Phase & phase : _phases )
+  {
+    if ( phase._name == name_r )
+    {
+      if ( phase._active && ! --phase._active )
+	close( phase, now_r );
+      return;
+    }
+  }
+}
+
+void PhaseProfile::stopAll( const Sample & now_r )
+{
+  std::lock_guard<std::mutex> lock( _mutex );
+  for ( Phase & phase : _phases )
+  {
+    if ( phase._active )
+    {
+      phase._active = 0;
+      close( phase, now_r );
+    }
+  }
+}
+
+void PhaseProfile::close( Phase & phase_r, const Sample & now_r )
+{
+  const Sample & start( phase_r._start );
+  phase_r._wall += now_r._wall - start._wall;
+  phase_r._cpu += now_r._cpu - start._cpu;
+  if ( start._maxrss >= 0 && now_r._maxrss >= 0 )
+    phase_r._rss += now_r._maxrss - start._maxrss;
+
+  long long read = knownDelta( start._read, now_r._read );
+  if ( read >= 0 )
+    phase_r._read = std::max( phase_r._read, 0LL ) + read;
+  long long written = knownDelta( start._written, now_r._written );
+  if ( written >= 0 )
+    phase_r._written = std::max( phase_r._written, 0LL ) + written;
+}
+
+std::vector<PhaseProfile::Phase> PhaseProfile::phases() const
+{
+  std::lock_guard<std::mutex> lock( _mutex );
+  return _phases;
+}
+
+bool PhaseProfile::empty() const
+{
+  std::lock_guard<std::mutex> lock( _mutex );
+  return _phases.empty();
+}
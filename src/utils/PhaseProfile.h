@@ -0,0 +1,127 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+#ifndef ZYPPER_UTILS_PHASEPROFILE_H
+#define ZYPPER_UTILS_PHASEPROFILE_H
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "TraceFile.h"
+
+///////////////////////////////////////////////////////////////////
+/// \class PhaseProfile
+/// \brief Wall time, CPU time, peak RSS growth and I/O per phase (--profile).
+///
+/// Phases are named and identified by their name. They are recorded in the
+/// order they first start. A phase started again accumulates. A phase
+/// started while it is still running just nests: it stops when the
+/// outermost \ref stop is called. Concurrent downloads are measured as a
+/// single "download" phase that way. A phase started while others are
+/// running is reported as their child (see \ref Phase::_depth).
+///
+/// Unless \ref enabled, \ref start and \ref stop do nothing, so they may be
+/// called unconditionally. (The overloads taking a \ref Sample always
+/// record.) Thread safe.
+///////////////////////////////////////////////////////////////////
+class PhaseProfile
+{
+public:
+  typedef std::chrono::steady_clock Clock;
+
+  /** Resource usage of the process at some point in time. */
+  struct Sample
+  {
+    Clock::time_point _wall;
+    std::chrono::microseconds _cpu { 0 };	///< user + system, incl. waited-for children
+    long _maxrss = -1;				///< peak RSS in KiB, -1 if unknown
+    long long _read = -1;			///< bytes read from storage, -1 if unknown
+    long long _written = -1;			///< bytes written to storage, -1 if unknown
+
+    /** The current values (getrusage, /proc/self/io). */
+    static Sample now();
+  };
+
+  struct Phase
+  {
+    std::string _name;
+    unsigned _depth = 0;			///< number of phases running when it first started
+    unsigned _count = 0;			///< how often it was started (not nested)
+    Clock::duration _wall { 0 };
+    std::chrono::microseconds _cpu { 0 };
+    long _rss = 0;				///< peak RSS growth in KiB
+    long long _read = -1;			///< -1 if unknown
+    long long _written = -1;			///< -1 if unknown
+
+    unsigned _active = 0;			///< nesting level if running
+    Sample _start;				///< if running
+  };
+
+  /** RAII: \ref start a phase, \ref stop it when leaving the scope.
+   * The phase is also written to the \ref TraceFile.
+   */
+  class Scope
+  {
+  public:
+    explicit Scope( std::string name_r, PhaseProfile & profile_r = PhaseProfile::instance() )
+    : _profile( profile_r )
+    , _name( std::move(name_r) )
+    , _trace( _name )
+    { _profile.start( _name ); }
+
+    ~Scope()
+    { _profile.stop( _name ); }
+
+    Scope( const Scope & ) = delete;
+    Scope & operator=( const Scope & ) = delete;
+
+  private:
+    PhaseProfile & _profile;
+    std::string _name;
+    TraceFile::Scope _trace;
+  };
+
+public:
+  /** The instance zypper reports at exit. */
+  static PhaseProfile & instance();
+
+  bool enabled() const
+  { return _enabled; }
+
+  void setEnabled( bool enabled_r = true )
+  { _enabled = enabled_r; }
+
+  /** Start phase \a name_r (or nest it if already running). */
+  void start( const std::string & name_r )
+  { if ( _enabled ) start( name_r, Sample::now() ); }
+  void start( const std::string & name_r, const Sample & now_r );
+
+  /** Stop phase \a name_r (or leave one nesting level). */
+  void stop( const std::string & name_r )
+  { if ( _enabled ) stop( name_r, Sample::now() ); }
+  void stop( const std::string & name_r, const Sample & now_r );
+
+  /** Stop all running phases (e.g. at exit). */
+  void stopAll()
+  { if ( _enabled ) stopAll( Sample::now() ); }
+  void stopAll( const Sample & now_r );
+
+  /** A copy of the phases recorded so far, in start order. */
+  std::vector<Phase> phases() const;
+
+  bool empty() const;
+
+private:
+  void close( Phase & phase_r, const Sample & now_r );
+
+  bool _enabled = false;
+  mutable std::mutex _mutex;
+  std::vector<Phase> _phases;	///< just a few, so no map
+};
+
+#endif // ZYPPER_UTILS_PHASEPROFILE_H
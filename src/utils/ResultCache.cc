@@ -0,0 +1,144 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+
+#include "ResultCache.h"
+
+namespace
+{
+  const char * magic = "zypper-result-cache 1";
+
+  /** FNV-1a, stable across builds (unlike std::hash). */
+  std::string hashString( const std::string & str_r )
+  {
+    unsigned long long hash = 14695981039346656037ULL;
+    for ( unsigned char ch : str_r )
+    {
+      hash ^= ch;
+      hash *= 1099511628211ULL;
+    }
+    char buf[17];
+    ::snprintf( buf, sizeof(buf), "%016llx", hash );
+    return buf;
+  }
+
+  /** mkdir -p */
+  bool assertDir( const std::string & dir_r )
+  {
+    for ( std::string::size_type pos = dir_r.find( '/', 1 ); ; pos = dir_r.find( '/', pos+1 ) )
+    {
+      std::string dir( dir_r.substr( 0, pos ) );
+      if ( ::mkdir( dir.c_str(), 0755 ) != 0 && errno != EEXIST )
+	return false;
+      if ( pos == std::string::npos )
+	return true;
+    }
+  }
+
+  /** Length prefixed, so values may contain anything. */
+  void writeField( std::ostream & str_r, const std::string & val_r )
+  { str_r << val_r.size() << "\n" << val_r << "\n"; }
+
+  bool readField( std::istream & str_r, std::string & val_r )
+  {
+    std::string::size_type size = 0;
+    if ( ! ( str_r >> size ) || str_r.get() != '\n' )
+      return false;
+    val_r.resize( size );
+    return( str_r.read( &val_r[0], size ) && str_r.get() == '\n' );
+  }
+} // namespace
+
+int ResultCache::Capture::Buf::overflow( int ch_r )
+{
+  if ( traits_type::eq_int_type( ch_r, traits_type::eof() ) )
+    return traits_type::not_eof( ch_r );
+  _data += traits_type::to_char_type( ch_r );
+  return _orig->sputc( traits_type::to_char_type( ch_r ) );
+}
+
+std::streamsize ResultCache::Capture::Buf::xsputn( const char * s_r, std::streamsize n_r )
+{
+  _data.append( s_r, n_r );
+  return _orig->sputn( s_r, n_r );
+}
+
+int ResultCache::Capture::Buf::sync()
+{ return _orig->pubsync(); }
+
+ResultCache::Capture::Capture( std::ostream & str_r )
+: _str( str_r )
+{
+  _buf._orig = _str.rdbuf( &_buf );
+}
+
+ResultCache::Capture::~Capture()
+{
+  _str.rdbuf( _buf._orig );
+}
+
+ResultCache::ResultCache( std::string dir_r )
+: _dir( std::move(dir_r) )
+{}
+
+std::string ResultCache::file( const std::string & query_r ) const
+{ return _dir + "/" + hashString( query_r ); }
+
+bool ResultCache::lookup( const std::string & query_r, const std::string & fingerprint_r, Entry & entry_r ) const
+{
+  std::ifstream str( file( query_r ).c_str() );
+  std::string line;
+  if ( ! std::getline( str, line ) || line != magic )
+    return false;
+
+  std::string query;
+  Entry entry;
+  if ( ! ( str >> entry._exitCode ) || str.get() != '\n'
+    || ! readField( str, query )
+    || ! readField( str, entry._fingerprint )
+    || ! readField( str, entry._output ) )
+    return false;
+
+  // the file name is just a hash
+  if ( query != query_r || entry._fingerprint != fingerprint_r )
+    return false;
+
+  entry_r = std::move(entry);
+  return true;
+}
+
+bool ResultCache::store( const std::string & query_r, const Entry & entry_r ) const
+{
+  if ( ! assertDir( _dir ) )
+    return false;
+
+  std::string target( file( query_r ) );
+  std::string tmp( target + "." + std::to_string( ::getpid() ) );
+  {
+    std::ofstream str( tmp.c_str(), std::ios_base::out | std::ios_base::trunc );
+    str << magic << "\n" << entry_r._exitCode << "\n";
+    writeField( str, query_r );
+    writeField( str, entry_r._fingerprint );
+    writeField( str, entry_r._output );
+    if ( ! str.flush() )
+    {
+      ::unlink( tmp.c_str() );
+      return false;
+    }
+  }
+  if ( ::rename( tmp.c_str(), target.c_str() ) != 0 )
+  {
+    ::unlink( tmp.c_str() );
+    return false;
+  }
+  return true;
+}
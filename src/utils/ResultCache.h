@@ -0,0 +1,88 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+#ifndef ZYPPER_UTILS_RESULTCACHE_H
+#define ZYPPER_UTILS_RESULTCACHE_H
+
+#include <iostream>
+#include <string>
+
+///////////////////////////////////////////////////////////////////
+/// \class ResultCache
+/// \brief Output of read-only queries remembered across zypper runs.
+///
+/// A query (e.g. the command line of a \c list-updates) has at most one
+/// entry, holding the output and exit code of its last run and the
+/// fingerprint of the system state it was computed for. The entry is
+/// replayed if the query is repeated and the fingerprint is unchanged.
+/// Storing a new result replaces the old entry, so the cache does not
+/// grow with the number of runs.
+///
+/// Each entry is a file in the cache directory. It is written to a
+/// temporary file first and renamed, so concurrent runs never see a
+/// partial entry.
+///////////////////////////////////////////////////////////////////
+class ResultCache
+{
+public:
+  struct Entry
+  {
+    std::string _fingerprint;	///< state of the system the result was computed for
+    int _exitCode = 0;
+    std::string _output;	///< what the query wrote to std::cout
+  };
+
+  /** RAII: remember what is written to a stream, while still writing it. */
+  class Capture
+  {
+  public:
+    explicit Capture( std::ostream & str_r = std::cout );
+    ~Capture();
+
+    Capture( const Capture & ) = delete;
+    Capture & operator=( const Capture & ) = delete;
+
+    /** What was written so far. */
+    const std::string & str() const
+    { return _buf._data; }
+
+  private:
+    struct Buf : public std::streambuf
+    {
+      int overflow( int ch_r ) override;
+      std::streamsize xsputn( const char * s_r, std::streamsize n_r ) override;
+      int sync() override;
+
+      std::streambuf * _orig = nullptr;
+      std::string _data;
+    };
+
+    std::ostream & _str;
+    Buf _buf;
+  };
+
+public:
+  explicit ResultCache( std::string dir_r );
+
+  const std::string & dir() const
+  { return _dir; }
+
+  /** The entry of \a query_r if it was computed for \a fingerprint_r. */
+  bool lookup( const std::string & query_r, const std::string & fingerprint_r, Entry & entry_r ) const;
+
+  /** Remember \a entry_r as the result of \a query_r.
+   * \return \c false if it can't be written (e.g. not root).
+   */
+  bool store( const std::string & query_r, const Entry & entry_r ) const;
+
+  /** The file holding the entry of \a query_r. */
+  std::string file( const std::string & query_r ) const;
+
+private:
+  std::string _dir;
+};
+
+#endif // ZYPPER_UTILS_RESULTCACHE_H
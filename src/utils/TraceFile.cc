@@ -0,0 +1,173 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+#include <unistd.h>
+
+#include <algorithm>
+#include <fstream>
+
+#include "XmlToJsonLines.h"	// jsonString
+#include "TraceFile.h"
+
+namespace
+{
+  const unsigned mainTid = 1;
+
+  inline long long micros( TraceFile::Clock::duration d_r )
+  { return std::chrono::duration_cast<std::chrono::microseconds>( d_r ).count(); }
+} // namespace
+
+const std::string TraceFile::mainCategory( "zypper" );
+
+TraceFile::Scope::Scope( std::string name_r, Args args_r, TraceFile & trace_r )
+: _trace( trace_r )
+{
+  if ( _trace.isOpen() )
+  {
+    _key = _trace.uniqueKey();
+    _trace.begin( _key, name_r, mainCategory, std::move(args_r) );
+  }
+}
+
+TraceFile::Scope::~Scope()
+{
+  if ( ! _key.empty() )
+    _trace.end( _key );
+}
+
+TraceFile::TraceFile()
+: _pid( ::getpid() )
+{}
+
+TraceFile::~TraceFile()
+{ close(); }
+
+TraceFile & TraceFile::instance()
+{
+  static TraceFile _instance;
+  return _instance;
+}
+
+bool TraceFile::open( const std::string & file_r )
+{
+  std::unique_ptr<std::ostream> file( new std::ofstream( file_r.c_str(), std::ios_base::out | std::ios_base::trunc ) );
+  if ( ! *file )
+    return false;
+  open( *file );
+  std::lock_guard<std::mutex> lock( _mutex );
+  _file = std::move(file);
+  return true;
+}
+
+void TraceFile::open( std::ostream & str_r )
+{
+  close();
+  std::lock_guard<std::mutex> lock( _mutex );
+  _str = &str_r;
+  _first = true;
+  _epoch = Clock::now();
+  *_str << "[";
+  writeThreadName( mainTid, mainCategory );
+}
+
+void TraceFile::close()
+{
+  if ( ! _str )
+    return;
+  Clock::time_point now( Clock::now() );
+  std::lock_guard<std::mutex> lock( _mutex );
+  for ( const auto & running : _running )
+    write( running.second, now );
+  _running.clear();
+  _busy.clear();
+  _named.clear();
+  _categories.clear();
+  *_str << "\n]\n" << std::flush;
+  _str = nullptr;
+  _file.reset();
+}
+
+std::string TraceFile::uniqueKey()
+{
+  std::lock_guard<std::mutex> lock( _mutex );
+  return "#" + std::to_string( ++_nextKey );
+}
+
+void TraceFile::begin( const std::string & key_r, const std::string & name_r, const std::string & category_r, Args args_r, Clock::time_point now_r )
+{
+  std::lock_guard<std::mutex> lock( _mutex );
+  if ( ! _str || _running.count( key_r ) )
+    return;
+  Event & event( _running[key_r] );
+  event._name = name_r;
+  event._category = category_r;
+  event._args = std::move(args_r);
+  event._tid = track( category_r );
+  event._start = now_r;
+}
+
+void TraceFile::end( const std::string & key_r, Args args_r, Clock::time_point now_r )
+{
+  std::lock_guard<std::mutex> lock( _mutex );
+  auto it = _running.find( key_r );
+  if ( ! _str || it == _running.end() )
+    return;
+  Event & event( it->second );
+  std::move( args_r.begin(), args_r.end(), std::back_inserter( event._args ) );
+  write( event, now_r );
+  _busy.erase( event._tid );
+  _running.erase( it );
+}
+
+unsigned TraceFile::track( const std::string & category_r )
+{
+  if ( category_r == mainCategory )
+    return mainTid;
+
+  auto cit = std::find( _categories.begin(), _categories.end(), category_r );
+  if ( cit == _categories.end() )
+    cit = _categories.insert( _categories.end(), category_r );
+  unsigned base = ( cit - _categories.begin() + 1 ) * 100;
+
+  unsigned tid = base;
+  while ( _busy.count( tid ) )
+    ++tid;
+  _busy.insert( tid );
+  if ( _named.insert( tid ).second )
+    writeThreadName( tid, category_r + " " + std::to_string( tid - base + 1 ) );
+  return tid;
+}
+
+void TraceFile::writeThreadName( unsigned tid_r, const std::string & name_r )
+{
+  *_str << ( _first ? "\n" : ",\n" )
+        << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << _pid << ",\"tid\":" << tid_r
+        << ",\"args\":{\"name\":" << XmlToJsonLines::jsonString( name_r ) << "}}";
+  _first = false;
+}
+
+void TraceFile::write( const Event & event_r, Clock::time_point end_r )
+{
+  *_str << ( _first ? "\n" : ",\n" )
+        << "{\"name\":" << XmlToJsonLines::jsonString( event_r._name )
+        << ",\"cat\":" << XmlToJsonLines::jsonString( event_r._category )
+        << ",\"ph\":\"X\",\"ts\":" << micros( event_r._start - _epoch )
+        << ",\"dur\":" << micros( end_r - event_r._start )
+        << ",\"pid\":" << _pid << ",\"tid\":" << event_r._tid;
+  if ( ! event_r._args.empty() )
+  {
+    *_str << ",\"args\":{";
+    const char * sep = "";
+    for ( const auto & arg : event_r._args )
+    {
+      *_str << sep << XmlToJsonLines::jsonString( arg.first ) << ":" << XmlToJsonLines::jsonString( arg.second );
+      sep = ",";
+    }
+    *_str << "}";
+  }
+  *_str << "}";
+  _first = false;
+}
@@ -0,0 +1,124 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+#ifndef ZYPPER_UTILS_TRACEFILE_H
+#define ZYPPER_UTILS_TRACEFILE_H
+
+#include <chrono>
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////
+/// \class TraceFile
+/// \brief Chrome trace event file of a zypper run (--trace-file).
+///
+/// Writes the JSON Array Format understood by chrome://tracing, Perfetto
+/// and speedscope. Each event is a complete event (\c "ph":"X") written
+/// as soon as it ends, so the file of an aborted run is still readable
+/// (the closing \c ] is optional in this format).
+///
+/// Events are started by \ref begin and ended by \ref end. A unique \c key
+/// identifies an event in between. Events in the \c "zypper" category run
+/// on the main thread and nest (phases, refresh, solver runs). Events of
+/// other categories may overlap (downloads, rpm steps). Each category gets
+/// its own set of tracks: an event is put on the first track of its
+/// category that is free when it begins. So the number of tracks shows the
+/// parallelism and gaps in a track show serialization.
+///
+/// Unless \ref open, \ref begin and \ref end do nothing, so they may be
+/// called unconditionally. Thread safe.
+///////////////////////////////////////////////////////////////////
+class TraceFile
+{
+public:
+  typedef std::chrono::steady_clock Clock;
+  typedef std::vector<std::pair<std::string,std::string>> Args;	///< event "args" (string values)
+
+  /** Category of the nesting events on the main track. */
+  static const std::string mainCategory;
+
+  /** RAII: trace a nesting event in \ref mainCategory. */
+  class Scope
+  {
+  public:
+    explicit Scope( std::string name_r, Args args_r = Args(), TraceFile & trace_r = TraceFile::instance() );
+    ~Scope();
+
+    Scope( const Scope & ) = delete;
+    Scope & operator=( const Scope & ) = delete;
+
+  private:
+    TraceFile & _trace;
+    std::string _key;
+  };
+
+public:
+  TraceFile();
+  ~TraceFile();
+
+  /** The instance written by zypper. */
+  static TraceFile & instance();
+
+  /** Start writing to \a file_r; \c false if it can't be created. */
+  bool open( const std::string & file_r );
+
+  /** Start writing to \a str_r (which must outlive the TraceFile). */
+  void open( std::ostream & str_r );
+
+  bool isOpen() const
+  { return _str != nullptr; }
+
+  /** End the events still running and finish the file. */
+  void close();
+
+  /** Start event \a key_r (ignored if already running). */
+  void begin( const std::string & key_r, const std::string & name_r, const std::string & category_r, Args args_r = Args() )
+  { if ( _str ) begin( key_r, name_r, category_r, std::move(args_r), Clock::now() ); }
+  void begin( const std::string & key_r, const std::string & name_r, const std::string & category_r, Args args_r, Clock::time_point now_r );
+
+  /** End event \a key_r, adding \a args_r (ignored if not running). */
+  void end( const std::string & key_r, Args args_r = Args() )
+  { if ( _str ) end( key_r, std::move(args_r), Clock::now() ); }
+  void end( const std::string & key_r, Args args_r, Clock::time_point now_r );
+
+  /** A key not used before (for events without a natural one). */
+  std::string uniqueKey();
+
+private:
+  struct Event
+  {
+    std::string _name;
+    std::string _category;
+    Args _args;
+    unsigned _tid;
+    Clock::time_point _start;
+  };
+
+  unsigned track( const std::string & category_r );
+  void write( const Event & event_r, Clock::time_point end_r );
+  void writeThreadName( unsigned tid_r, const std::string & name_r );
+
+  std::unique_ptr<std::ostream> _file;
+  std::ostream * _str = nullptr;
+  bool _first = true;
+  Clock::time_point _epoch;
+  unsigned long _pid;
+  unsigned long _nextKey = 0;
+  std::mutex _mutex;
+
+  std::map<std::string,Event> _running;	///< by key
+  std::vector<std::string> _categories;	///< tid is (index+1) * 100 + track; the main track is tid 1
+  std::set<unsigned> _busy;		///< tracks with a running event (not the main track)
+  std::set<unsigned> _named;		///< tracks with a thread_name written
+};
+
+#endif // ZYPPER_UTILS_TRACEFILE_H
@@ -0,0 +1,384 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unordered_set>
+
+#include "utils/XmlToJsonLines.h"
+
+namespace
+{
+  inline bool isSpace( char ch_r )
+  { return( ch_r == ' ' || ch_r == '\t' || ch_r == '\n' || ch_r == '\r' ); }
+
+  inline bool isBlank( const std::string & text_r )
+  {
+    for ( char ch : text_r )
+      if ( ! isSpace( ch ) )
+	return false;
+    return true;
+  }
+
+  /** \a text_r without leading and trailing whitespace (formatting). */
+  inline std::string trimmed( const std::string & text_r )
+  {
+    std::string::size_type b = 0;
+    std::string::size_type e = text_r.size();
+    while ( b < e && isSpace( text_r[b] ) )
+      ++b;
+    while ( e > b && isSpace( text_r[e-1] ) )
+      --e;
+    return text_r.substr( b, e - b );
+  }
+
+  inline bool startsWith( const std::string & str_r, const char * prefix_r )
+  { return str_r.compare( 0, ::strlen( prefix_r ), prefix_r ) == 0; }
+
+  inline bool endsWith( const std::string & str_r, const char * suffix_r )
+  {
+    size_t len = ::strlen( suffix_r );
+    return str_r.size() >= len && str_r.compare( str_r.size() - len, len, suffix_r ) == 0;
+  }
+
+  void appendUtf8( std::string & str_r, unsigned long cp_r )
+  {
+    if ( cp_r < 0x80 )
+      str_r += char(cp_r);
+    else if ( cp_r < 0x800 )
+    {
+      str_r += char( 0xC0 | ( cp_r >> 6 ) );
+      str_r += char( 0x80 | ( cp_r & 0x3F ) );
+    }
+    else if ( cp_r < 0x10000 )
+    {
+      str_r += char( 0xE0 | ( cp_r >> 12 ) );
+      str_r += char( 0x80 | ( ( cp_r >> 6 ) & 0x3F ) );
+      str_r += char( 0x80 | ( cp_r & 0x3F ) );
+    }
+    else
+    {
+      str_r += char( 0xF0 | ( cp_r >> 18 ) );
+      str_r += char( 0x80 | ( ( cp_r >> 12 ) & 0x3F ) );
+      str_r += char( 0x80 | ( ( cp_r >> 6 ) & 0x3F ) );
+      str_r += char( 0x80 | ( cp_r & 0x3F ) );
+    }
+  }
+}
+
+XmlToJsonLines::XmlToJsonLines( std::streambuf * target_r )
+: _target( target_r )
+, _inTag( false )
+, _quote( '\0' )
+{}
+
+XmlToJsonLines::~XmlToJsonLines()
+{
+  if ( ! _inTag )
+  {
+    _text += xmlUnescape( _raw );
+    _raw.clear();
+    flushText();
+  }
+  _target->pubsync();
+}
+
+bool XmlToJsonLines::isStreamed( const std::string & name_r )
+{
+  static const std::unordered_set<std::string> streamed {
+    "search-result", "solvable-list", "selectable-list",
+    "update-status", "update-list", "blocked-update-list",
+    "list-patches-byissue", "issue-matches", "description-matches",
+    "install-summary", "to-install", "to-remove", "to-upgrade", "to-downgrade",
+    "to-upgrade-change-arch", "to-downgrade-change-arch", "to-reinstall", "to-change-arch",
+    "repo-list", "service-list", "locks",
+  };
+  return streamed.count( name_r );
+}
+
+std::string XmlToJsonLines::jsonString( const std::string & text_r )
+{
+  std::string ret;
+  ret.reserve( text_r.size() + 2 );
+  ret += '"';
+  for ( char ch : text_r )
+  {
+    switch ( ch )
+    {
+      case '"':  ret += "\\\""; break;
+      case '\\': ret += "\\\\"; break;
+      case '\n': ret += "\\n"; break;
+      case '\r': ret += "\\r"; break;
+      case '\t': ret += "\\t"; break;
+      case '\b': ret += "\\b"; break;
+      case '\f': ret += "\\f"; break;
+      default:
+	if ( (unsigned char)ch < 0x20 )
+	{
+	  char buf[8];
+	  ::snprintf( buf, sizeof(buf), "\\u%04x", (unsigned char)ch );
+	  ret += buf;
+	}
+	else
+	  ret += ch;	// UTF-8 is passed as it is
+	break;
+    }
+  }
+  ret += '"';
+  return ret;
+}
+
+std::string XmlToJsonLines::xmlUnescape( const std::string & text_r )
+{
+  std::string::size_type amp = text_r.find( '&' );
+  if ( amp == std::string::npos )
+    return text_r;
+
+  std::string ret( text_r, 0, amp );
+  while ( amp != std::string::npos )
+  {
+    std::string::size_type semi = text_r.find( ';', amp );
+    if ( semi == std::string::npos )
+      break;
+    std::string ref( text_r, amp + 1, semi - amp - 1 );
+    if ( ref == "lt" )
+      ret += '<';
+    else if ( ref == "gt" )
+      ret += '>';
+    else if ( ref == "amp" )
+      ret += '&';
+    else if ( ref == "quot" )
+      ret += '"';
+    else if ( ref == "apos" )
+      ret += '\'';
+    else if ( ref.size() > 1 && ref[0] == '#' )
+    {
+      bool hex = ( ref[1] == 'x' || ref[1] == 'X' );
+      appendUtf8( ret, ::strtoul( ref.c_str() + ( hex ? 2 : 1 ), nullptr, hex ? 16 : 10 ) );
+    }
+    else
+      ret.append( text_r, amp, semi - amp + 1 );	// unknown: keep it
+
+    std::string::size_type next = text_r.find( '&', semi + 1 );
+    ret.append( text_r, semi + 1, next == std::string::npos ? std::string::npos : next - semi - 1 );
+    amp = next;
+  }
+  if ( amp != std::string::npos )
+    ret.append( text_r, amp, std::string::npos );
+  return ret;
+}
+
+XmlToJsonLines::int_type XmlToJsonLines::overflow( int_type ch )
+{
+  if ( ! traits_type::eq_int_type( ch, traits_type::eof() ) )
+    feed( traits_type::to_char_type( ch ) );
+  return traits_type::not_eof( ch );
+}
+
+std::streamsize XmlToJsonLines::xsputn( const char * s, std::streamsize n )
+{
+  for ( std::streamsize i = 0; i < n; ++i )
+    feed( s[i] );
+  return n;
+}
+
+int XmlToJsonLines::sync()
+{ return _target->pubsync(); }
+
+void XmlToJsonLines::feed( char ch )
+{
+  if ( ! _inTag )
+  {
+    if ( ch == '<' )
+    {
+      _text += xmlUnescape( _raw );
+      _raw.clear();
+      _tag.clear();
+      _inTag = true;
+    }
+    else
+      _raw += ch;
+    return;
+  }
+
+  if ( _quote )
+  {
+    if ( ch == _quote )
+      _quote = '\0';
+  }
+  else if ( ch == '>' )
+  {
+    // comments and CDATA may contain a '>'
+    if ( ( startsWith( _tag, "!--" ) && ! endsWith( _tag, "--" ) )
+      || ( startsWith( _tag, "![CDATA[" ) && ! endsWith( _tag, "]]" ) ) )
+    {
+      _tag += ch;
+      return;
+    }
+    _inTag = false;
+    markup();
+    return;
+  }
+  else if ( ( ch == '"' || ch == '\'' ) && ! _tag.empty() && _tag[0] != '!' && _tag[0] != '?' )
+    _quote = ch;
+  _tag += ch;
+}
+
+void XmlToJsonLines::markup()
+{
+  if ( _tag.empty() || _tag[0] == '?' )
+    return;	// processing instruction
+
+  if ( _tag[0] == '!' )
+  {
+    if ( startsWith( _tag, "![CDATA[" ) )
+      _text.append( _tag, 8, _tag.size() - 10 );
+    return;	// comment or DOCTYPE
+  }
+
+  flushText();
+  if ( _tag[0] == '/' )
+    endElement();
+  else if ( _tag.back() == '/' )
+    startElement( _tag.substr( 0, _tag.size() - 1 ), true );
+  else
+    startElement( _tag, false );
+}
+
+void XmlToJsonLines::startElement( const std::string & tag_r, bool empty_r )
+{
+  Element el;
+  std::string::size_type pos = 0;
+  while ( pos < tag_r.size() && ! isSpace( tag_r[pos] ) )
+    ++pos;
+  el._name = tag_r.substr( 0, pos );
+
+  while ( true )
+  {
+    while ( pos < tag_r.size() && isSpace( tag_r[pos] ) )
+      ++pos;
+    if ( pos == tag_r.size() )
+      break;
+
+    std::string::size_type nend = pos;
+    while ( nend < tag_r.size() && tag_r[nend] != '=' && ! isSpace( tag_r[nend] ) )
+      ++nend;
+    std::string name( tag_r, pos, nend - pos );
+    pos = tag_r.find_first_of( "\"'", nend );
+    if ( pos == std::string::npos )
+    {
+      el._attrs.push_back( { std::move(name), std::string() } );
+      break;	// malformed
+    }
+    std::string::size_type vend = tag_r.find( tag_r[pos], pos + 1 );
+    if ( vend == std::string::npos )
+      vend = tag_r.size();
+    el._attrs.push_back( { std::move(name), xmlUnescape( tag_r.substr( pos + 1, vend - pos - 1 ) ) } );
+    pos = std::min( vend + 1, tag_r.size() );
+  }
+
+  el._root = ( _stack.empty() && el._name == "stream" );
+  el._streamed = el._root || ( streaming() && isStreamed( el._name ) );
+  if ( el._streamed && ! el._root )
+    writeLine( toJson( el, "begin" ) );
+  _stack.push_back( std::move(el) );
+
+  if ( empty_r )
+    endElement();
+}
+
+void XmlToJsonLines::endElement()
+{
+  if ( _stack.empty() )
+    return;	// unbalanced
+
+  Element el( std::move(_stack.back()) );
+  _stack.pop_back();
+  if ( el._root )
+    return;
+
+  if ( el._streamed )
+  {
+    el._attrs.clear();
+    writeLine( toJson( el, "end" ) );
+  }
+  else if ( streaming() )
+    writeLine( toJson( el ) );
+  else
+    _stack.back()._children.push_back( toJson( el ) );
+}
+
+void XmlToJsonLines::flushText()
+{
+  if ( _text.empty() )
+    return;
+
+  if ( streaming() )
+  {
+    if ( ! isBlank( _text ) )
+      writeLine( "{\"element\":\"text\",\"text\":" + jsonString( trimmed( _text ) ) + "}" );
+  }
+  else
+    _stack.back()._text += _text;
+  _text.clear();
+}
+
+bool XmlToJsonLines::streaming() const
+{ return _stack.empty() || _stack.back()._streamed; }
+
+void XmlToJsonLines::writeLine( const std::string & json_r )
+{
+  _target->sputn( json_r.data(), json_r.size() );
+  _target->sputc( '\n' );
+}
+
+std::string XmlToJsonLines::toJson( const Element & element_r, const char * event_r )
+{
+  std::string ret( "{\"element\":" );
+  ret += jsonString( element_r._name );
+  if ( event_r )
+  {
+    ret += ",\"event\":\"";
+    ret += event_r;
+    ret += '"';
+  }
+  if ( ! element_r._attrs.empty() )
+  {
+    ret += ",\"attributes\":{";
+    const char * sep = "";
+    for ( const auto & attr : element_r._attrs )
+    {
+      ret += sep;
+      ret += jsonString( attr.first );
+      ret += ':';
+      ret += jsonString( attr.second );
+      sep = ",";
+    }
+    ret += '}';
+  }
+  if ( ! event_r && ! isBlank( element_r._text ) )
+  {
+    ret += ",\"text\":";
+    // mixed content: whitespace around the children is just formatting
+    ret += jsonString( element_r._children.empty() ? element_r._text : trimmed( element_r._text ) );
+  }
+  if ( ! element_r._children.empty() )
+  {
+    ret += ",\"children\":[";
+    const char * sep = "";
+    for ( const std::string & child : element_r._children )
+    {
+      ret += sep;
+      ret += child;
+      sep = ",";
+    }
+    ret += ']';
+  }
+  ret += '}';
+  return ret;
+}
@@ -0,0 +1,93 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+#ifndef ZYPPER_UTILS_XMLTOJSONLINES_H
+#define ZYPPER_UTILS_XMLTOJSONLINES_H
+
+#include <streambuf>
+#include <string>
+#include <vector>
+#include <utility>
+
+///////////////////////////////////////////////////////////////////
+/// \class XmlToJsonLines
+/// \brief A streambuf translating zypper's XML output stream into JSON Lines.
+///
+/// Everything written to it is parsed as zypper's XML output (see
+/// xmlout.rnc) and each complete top level element is written to the
+/// target streambuf as a single line holding one JSON object:
+/// \code
+///   <message type="info">Done.</message>
+///   {"element":"message","attributes":{"type":"info"},"text":"Done."}
+/// \endcode
+/// \c attributes, \c text (unless whitespace only) and \c children
+/// (the nested elements in document order) are omitted if empty. Attribute
+/// values are passed as strings. The \c <stream> root element itself is
+/// transparent. Text outside any element is written (trimmed) as
+/// \c {"element":"text","text":"..."}.
+///
+/// Lists which may be huge (search results, updates, repos, summaries...)
+/// are not collected. Their start and end is written as separate lines with
+/// an \c "event" of \c "begin" or \c "end", and their children are written
+/// one per line in between. So a consumer is able to process e.g. each
+/// search result row as soon as it arrives.
+///
+/// The XML is expected to be well formed; there is no validation.
+///////////////////////////////////////////////////////////////////
+class XmlToJsonLines : public std::streambuf
+{
+public:
+  /** Write the JSON Lines to \a target_r. */
+  explicit XmlToJsonLines( std::streambuf * target_r );
+
+  /** Flushes pending text. */
+  ~XmlToJsonLines();
+
+  /** Whether the children of element \a name_r are written one per line. */
+  static bool isStreamed( const std::string & name_r );
+
+  /** \a text_r quoted and escaped as JSON string. */
+  static std::string jsonString( const std::string & text_r );
+
+  /** \a text_r with the XML character and entity references resolved. */
+  static std::string xmlUnescape( const std::string & text_r );
+
+protected:
+  int_type overflow( int_type ch ) override;
+  std::streamsize xsputn( const char * s, std::streamsize n ) override;
+  int sync() override;
+
+private:
+  struct Element
+  {
+    std::string _name;
+    std::vector<std::pair<std::string,std::string>> _attrs;
+    std::string _text;
+    std::vector<std::string> _children;	///< as JSON
+    bool _streamed;	///< children are written as lines
+    bool _root;		///< the transparent <stream>
+  };
+
+  void feed( char ch );
+  void markup();
+  void startElement( const std::string & tag_r, bool empty_r );
+  void endElement();
+  void flushText();
+  /** Whether children of the top element are written as lines. */
+  bool streaming() const;
+  void writeLine( const std::string & json_r );
+  static std::string toJson( const Element & element_r, const char * event_r = nullptr );
+
+  std::streambuf * _target;
+  std::vector<Element> _stack;
+  std::string _raw;		///< pending character data
+  std::string _text;		///< pending unescaped character data
+  std::string _tag;		///< pending markup (after '<')
+  bool _inTag;
+  char _quote;			///< quote char if within an attribute value
+};
+
+#endif // ZYPPER_UTILS_XMLTOJSONLINES_H
@@ -7,6 +7,7 @@
 
 #include <sstream>
 #include <iostream>
+#include <map>
 #include <unistd.h>          // for getcwd()
 
 #include <zypp/base/Logger.h>
@@ -19,6 +20,8 @@
 #include <zypp/parser/HistoryLogReader.h>
 
 #include <zypp/ZYpp.h>
+#include <zypp/ResPool.h>
+#include <zypp/ResPoolProxy.h>
 #include <zypp/Target.h>
 #include <zypp/PoolItem.h>
 #include <zypp/Product.h>
@@ -32,6 +35,8 @@
 
 #include "utils/misc.h"
 #include "utils/XmlFilter.h"
+#include "utils/FuzzyNameIndex.h"
+#include "utils/HistoryIndex.h"
 
 extern ZYpp::Ptr God;
 
@@ -233,15 +238,12 @@ std::string patchInteractiveFlags( const Patch & patch_r )
 /// class  PatchHistoryData
 struct PatchHistoryData::D
 {
-  void remember( HistoryLogPatchStateChange::Ptr ptr_r )
+  void remember( const HistoryIndex::Entry & entry_r )
   {
-    if ( ! ptr_r )
-      return;
-
-    value_type & value { _data[IdString("patch:"+ptr_r->name()).id()][ptr_r->edition().id()][ptr_r->arch().id()] };
-    if ( Date date { ptr_r->date() }; date > value.first ) {
+    value_type & value { _data[IdString("patch:"+entry_r._name).id()][Edition(entry_r._edition).id()][Arch(entry_r._arch).id()] };
+    if ( Date date { Date::ValueType(entry_r._date) }; date > value.first ) {
       value.first = std::move(date);
-      value.second = ResStatus::stringToValidateValue( ptr_r->newstate() );
+      value.second = ResStatus::stringToValidateValue( entry_r._state );
     }
   }
 
@@ -270,20 +272,55 @@ const PatchHistoryData::value_type PatchHistoryData::noData( Date(), ResStatus::
 PatchHistoryData PatchHistoryData::placeholder()
 { return PatchHistoryData( false ); }
 
+namespace
+{
+  /** A history log line if it is a patch state change (like HistoryLogReader parses it). */
+  HistoryLogPatchStateChange::Ptr parsePatchStateChange( const std::string & line_r )
+  {
+    if ( line_r.empty() || line_r[0] == '#' )
+      return nullptr;
+
+    HistoryLogData::FieldVector fields;
+    str::splitEscaped( line_r, std::back_inserter(fields), "|", true );
+    if ( fields.size() <= HistoryLogData::ACTION_INDEX
+      || HistoryActionID( str::trim( fields[HistoryLogData::ACTION_INDEX] ) ) != HistoryActionID::PATCH_STATE_CHANGE )
+      return nullptr;
+
+    try
+    {
+      return dynamic_pointer_cast<HistoryLogPatchStateChange>( HistoryLogData::create( fields ) );
+    }
+    catch ( const Exception & excpt )
+    {
+      ZYPP_CAUGHT( excpt );	// IGNORE_INVALID_ITEMS
+    }
+    return nullptr;
+  }
+}
+
 PatchHistoryData::PatchHistoryData( bool doparse_r )
 {
   if ( doparse_r )
   {
-    const Pathname & historyFile { Pathname::assertprefix( Zypper::instance().config().root_dir, ZConfig::instance().historyLogFile() ) };
-    parser::HistoryLogReader parser( historyFile, parser::HistoryLogReader::IGNORE_INVALID_ITEMS,
-				     [=]( HistoryLogData::Ptr ptr_r )->bool {
-				       if ( ! this->_d )
-					 this->_d.reset( new D );
-				       this->_d->remember( dynamic_pointer_cast<HistoryLogPatchStateChange>(ptr_r) );
-				       return true;
-				     } );
-    parser.addActionFilter( HistoryActionID::PATCH_STATE_CHANGE );
-    parser.readAll();
+    // The history file is parsed incrementally; the index remembers what was found so far.
+    const Pathname & root { Zypper::instance().config().root_dir };
+    const Pathname & historyFile { Pathname::assertprefix( root, ZConfig::instance().historyLogFile() ) };
+    HistoryIndex index( Pathname::assertprefix( root, ZYPPER_HISTORY_INDEX_FILE ).asString() );
+    long long offset = index.offset();
+    index.update( historyFile.asString(), [&index]( const std::string & line_r ) {
+      if ( HistoryLogPatchStateChange::Ptr ptr { parsePatchStateChange( line_r ) } )
+	index.remember( { ptr->name(), ptr->edition().asString(), ptr->arch().asString(), Date::ValueType(ptr->date()), ptr->newstate() } );
+    } );
+    DBG << historyFile << " indexed up to offset " << index.offset() << " (was " << offset << ")" << endl;
+    if ( index.offset() != offset && ! index.save() )
+      DBG << "Can't write the history index " << ZYPPER_HISTORY_INDEX_FILE << endl;
+
+    if ( ! index.entries().empty() )
+    {
+      _d.reset( new D );
+      for ( const auto & el : index.entries() )
+	_d->remember( el.second );
+    }
   }
 }
 
@@ -897,3 +934,106 @@ const char * computeStatusIndicator( const ui::Selectable & sel_r, bool tagForei
     return stem[1];
   return stem[0];
 }
+
+StatusIndicatorCache & StatusIndicatorCache::instance()
+{
+  static StatusIndicatorCache _instance;
+  return _instance;
+}
+
+void StatusIndicatorCache::clear()
+{
+  _entries.clear();
+  _selEntries[0].clear();
+  _selEntries[1].clear();
+}
+
+void StatusIndicatorCache::checkPoolSerial()
+{
+  if ( _poolWatcher.remember( ResPool::instance().serial() ) )
+    clear();
+}
+
+void StatusIndicatorCache::fill( const ui::Selectable::constPtr & sel_r )
+{
+  ui::Selectable::picklist_size_type pos = 0;
+  for ( const PoolItem & pi : sel_r->picklist() )
+  {
+    Entry & entry { _entries[pi.satSolvable()] };
+    entry._sel = sel_r;
+    entry._picklistPos = pos++;
+    entry._statusIndicator = computeStatusIndicator( pi, sel_r, &entry._iType );
+  }
+  // installed items with an identical available are not in the picklist
+  for ( const PoolItem & pi : sel_r->installed() )
+  {
+    Entry & entry { _entries[pi.satSolvable()] };
+    if ( ! entry._sel )
+    {
+      entry._sel = sel_r;
+      entry._statusIndicator = computeStatusIndicator( pi, sel_r, &entry._iType );
+    }
+  }
+}
+
+const StatusIndicatorCache::Entry & StatusIndicatorCache::operator[]( const PoolItem & pi_r )
+{
+  checkPoolSerial();
+  auto it = _entries.find( pi_r.satSolvable() );
+  if ( it == _entries.end() )
+  {
+    fill( ui::Selectable::get( pi_r ) );
+    it = _entries.find( pi_r.satSolvable() );
+    if ( it == _entries.end() )	// not expected: not an item of its Selectable
+    {
+      Entry & entry { _entries[pi_r.satSolvable()] };
+      entry._sel = ui::Selectable::get( pi_r );
+      entry._statusIndicator = computeStatusIndicator( pi_r, entry._sel, &entry._iType );
+      return entry;
+    }
+  }
+  return it->second;
+}
+
+const char * StatusIndicatorCache::selectableStatusIndicator( const ui::Selectable & sel_r, bool tagForeign_r, bool * iType_r )
+{
+  checkPoolSerial();
+  auto & entries { _selEntries[tagForeign_r ? 1 : 0] };
+  auto it = entries.find( &sel_r );
+  if ( it == entries.end() )
+  {
+    bool iType = false;
+    const char * statusIndicator = computeStatusIndicator( sel_r, tagForeign_r, &iType );
+    it = entries.insert( { &sel_r, { statusIndicator, iType } } ).first;
+  }
+  if ( iType_r ) *iType_r = it->second.second;
+  return it->second.first;
+}
+
+std::string similarNamesHint( const std::string & name_r, const ResKind & kind_r )
+{
+  static std::map<ResKind, FuzzyNameIndex> indices;
+  static SerialNumberWatcher poolWatcher;
+  if ( poolWatcher.remember( ResPool::instance().serial() ) )
+    indices.clear();
+
+  auto it = indices.find( kind_r );
+  if ( it == indices.end() )
+  {
+    FuzzyNameIndex & index { indices[kind_r] };
+    const ResPoolProxy & proxy { ResPool::instance().proxy() };
+    for_( sel, proxy.byKindBegin( kind_r ), proxy.byKindEnd( kind_r ) )
+      index.add( (*sel)->name() );
+    MIL << "Built name index for " << kind_r << ": " << index.size() << " names" << endl;
+    it = indices.find( kind_r );
+  }
+
+  std::string ret;
+  for ( const std::string & name : it->second.lookup( name_r, FuzzyNameIndex::defaultMaxDistance( name_r.size() ) ) )
+  {
+    if ( ! ret.empty() )
+      ret += ", ";
+    ret += name;
+  }
+  return ret;
+}
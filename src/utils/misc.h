@@ -12,6 +12,7 @@
 #include <string>
 #include <set>
 #include <list>
+#include <unordered_map>
 
 #include <zypp/Url.h>
 #include <zypp/Date.h>
@@ -20,6 +21,7 @@
 #include <zypp/ui/Selectable.h>
 #include <zypp/ZYppCommitPolicy.h>
 #include <zypp/base/Logger.h>
+#include <zypp/base/SerialNumber.h>
 
 class Zypper;
 class Table;
@@ -101,6 +103,69 @@ inline const char * computeStatusIndicator( const ui::Selectable & sel_r, bool *
 inline const char * computeStatusIndicator( const ui::Selectable & sel_r, const Edition &installedMustHaveEd )
 { return computeStatusIndicator( sel_r ); }
 
+///////////////////////////////////////////////////////////////////
+/// \class StatusIndicatorCache
+/// \brief Picklist position and status indicator computed once per \ref ui::Selectable.
+///
+/// Listing commands (search, packages, patterns, products, info) need
+/// the picklist position and \ref computeStatusIndicator for every row.
+/// The cache computes them for all items of a Selectable at once and
+/// remembers them until the pool content changes. Items status changes
+/// (e.g. after running the resolver) require an explicit \ref clear.
+///
+/// Installed items having an identical available one are not part of
+/// the picklist. Their \ref Entry::_picklistPos is \c picklistNoPos,
+/// so they can be discarded without further computation.
+///////////////////////////////////////////////////////////////////
+class StatusIndicatorCache
+{
+public:
+  struct Entry
+  {
+    ui::Selectable::constPtr _sel;
+    ui::Selectable::picklist_size_type _picklistPos = ui::Selectable::picklistNoPos;
+    const char * _statusIndicator = nullptr;
+    bool _iType = false;	///< treated as (i)nstalled
+  };
+
+  /** The global cache. */
+  static StatusIndicatorCache & instance();
+
+  /** The cached data for \a pi_r. */
+  const Entry & operator[]( const PoolItem & pi_r );
+
+  /** The cached \ref computeStatusIndicator for a \ref ui::Selectable. */
+  const char * selectableStatusIndicator( const ui::Selectable & sel_r, bool tagForeign_r = false, bool * iType_r = nullptr );
+
+  /** Forget all cached data (e.g. after items status changed). */
+  void clear();
+
+private:
+  void checkPoolSerial();
+  void fill( const ui::Selectable::constPtr & sel_r );
+
+  std::unordered_map<sat::Solvable, Entry> _entries;
+  std::unordered_map<const ui::Selectable *, std::pair<const char *, bool>> _selEntries[2];	// [tagForeign]
+  SerialNumberWatcher _poolWatcher;
+};
+
+/** \relates StatusIndicatorCache Convenience to lookup \ref computeStatusIndicator in the global cache. */
+inline const char * cachedStatusIndicator( const PoolItem & pi_r, bool * iType_r = nullptr )
+{
+  const StatusIndicatorCache::Entry & entry { StatusIndicatorCache::instance()[pi_r] };
+  if ( iType_r ) *iType_r = entry._iType;
+  return entry._statusIndicator;
+}
+/** \overload for \ref ui::Selectable */
+inline const char * cachedStatusIndicator( const ui::Selectable & sel_r, bool tagForeign_r = false, bool * iType_r = nullptr )
+{ return StatusIndicatorCache::instance().selectableStatusIndicator( sel_r, tagForeign_r, iType_r ); }
+
+
+/** Typo hint: names of \a kind_r Selectables closest to \a name_r (','-separated), or an empty string.
+ * The name index is built on first use and kept until the pool content changes.
+ */
+std::string similarNamesHint( const std::string & name_r, const ResKind & kind_r = ResKind::package );
+
 
 /** Whether running on SLE.
  * If so, report e.g. unsupported packages per default.
@@ -57,6 +57,7 @@ static bool show_in_pager( const std::string & pager, const Pathname & file )
 
   std::string errmsg;
   pid_t pid;
+  Out::flush();
   switch( pid = fork() )
   {
   case -1:
@@ -360,6 +360,7 @@ unsigned get_prompt_reply( Zypper & zypper, PromptId pid, const PromptOptions &
 
   // PENDING SigINT? Some frequently called place to avoid exiting from within the signal handler?
   zypper.immediateExitCheck();
+  Out::flush();
 
   // open a terminal for input (bnc #436963)
   std::ifstream stm( "/dev/tty" );
@@ -469,6 +470,7 @@ std::string get_text( const std::string & prompt, const std::string & prefilled
   /* Get a line from the user. */
   prefill = prefilled.c_str();
   rl_pre_input_hook = init_line;
+  Out::flush();
   if ( char * line_read = ::readline( prompt.c_str() ) )
   {
     ret = line_read;
@@ -6,9 +6,55 @@
 \*---------------------------------------------------------------------------*/
 
 #include <cstring>
+#include <cstdint>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 #include <boost/utility/string_ref.hpp>
 #include "utils/text.h"
 
+size_t mbs::printableAsciiPrefix( boost::string_ref text_r )
+{
+  const char * const begin = text_r.data();
+  const char * const end = begin + text_r.size();
+  const char * p = begin;
+
+#if defined(__SSE2__)
+  // 16 bytes at once; compared signed, so bytes >= 0x80 fail the lower bound
+  const __m128i lower = _mm_set1_epi8( 0x1f );
+  const __m128i upper = _mm_set1_epi8( 0x7f );
+  for ( ; end - p >= 16; p += 16 )
+  {
+    __m128i chunk = _mm_loadu_si128( reinterpret_cast<const __m128i *>( p ) );
+    __m128i ok = _mm_and_si128( _mm_cmpgt_epi8( chunk, lower ), _mm_cmplt_epi8( chunk, upper ) );
+    unsigned mask = _mm_movemask_epi8( ok );
+    if ( mask != 0xffff )
+      return ( p - begin ) + __builtin_ctz( ~mask );
+  }
+#else
+  // 8 bytes at once; stop at a word containing a byte >= 0x80, < 0x20 or == 0x7f
+  // and let the byte loop below find its position.
+  constexpr uint64_t ones  = 0x0101010101010101ULL;
+  constexpr uint64_t highs = 0x8080808080808080ULL;
+  for ( ; end - p >= 8; p += 8 )
+  {
+    uint64_t w;
+    ::memcpy( &w, p, sizeof(w) );
+    uint64_t del = w ^ ( 0x7f * ones );
+    if ( ( w | ( ( w - 0x20 * ones ) & ~w ) | ( ( del - ones ) & ~del ) ) & highs )
+      break;
+  }
+#endif
+
+  for ( ; p != end; ++p )
+  {
+    unsigned char ch = *p;
+    if ( ch < 0x20 || ch > 0x7e )
+      break;
+  }
+  return p - begin;
+}
+
 std::string mbs_substr_by_width( boost::string_ref text_r, std::string::size_type colpos_r, std::string::size_type collen_r )
 {
   std::string ret;
@@ -18,6 +64,15 @@ std::string mbs_substr_by_width( boost::string_ref text_r, std::string::size_typ
     size_t slen		= 0;
 
     size_t colend = ( collen_r == std::string::npos ? std::string::npos : colpos_r+collen_r ); // will exploit npos == size_t(-1)
+
+    // range within a printable ASCII prefix: columns are bytes
+    size_t ascii = mbs::printableAsciiPrefix( text_r );
+    if ( ascii == text_r.size() || colend <= ascii )
+    {
+      if ( colpos_r < ascii )
+	ret.assign( text_r.data() + colpos_r, std::min( collen_r, ascii - colpos_r ) );
+      return ret;
+    }
     size_t pos = 0;
     for( mbs::MbsIterator it( text_r ); ! it.atEnd(); ++it )
     {
@@ -24,6 +24,13 @@ namespace mbs
 {
 #define ZYPPER_TRACE_MBS 0
 
+  /** Length of the leading run of printable ASCII chars (0x20-0x7E) in \a text_r.
+   * Within such a run each byte is a char occupying one screen column. There
+   * are no multi-byte chars, controls or ANSI SGR, so the slow \ref MbsIterator
+   * is needed only after its end. The scan is vectorized where available.
+   */
+  size_t printableAsciiPrefix( boost::string_ref text_r );
+
   struct MbToWc
   {
     static const char _oooooooo = 0000;
@@ -410,38 +417,71 @@ namespace mbs
      */
     void write( boost::string_ref text_r, bool leadingWSindents_r = true )
     {
-      for( MbsIterator it( text_r ); ! it.atEnd(); ++it )
+      while ( ! text_r.empty() )
       {
-	if ( it.isNL() )
+	// plain ASCII run: bytes are chars of one column and ' ' is the only WS
+	size_t ascii = printableAsciiPrefix( text_r );
+	for ( const char * p = text_r.data(), * e = p + ascii; p != e; )
 	{
-	  gotoNextPar();	// write out any pending word and start new par
-	}
-	else if ( it.isWS() )
-	{
-	  if ( _word )		// write out pending word and start new gap
+	  if ( *p == ' ' )
 	  {
-	    writeout();
-	    ++_gap;
+	    addWS( leadingWSindents_r );
+	    ++p;
 	  }
 	  else
 	  {
-	    if ( atParBegin() && leadingWSindents_r )	// ws at par begin may increment indent
-	      ++_indentGap;
-	    else
-	      ++_gap;
+	    const char * w = static_cast<const char *>( ::memchr( p, ' ', e - p ) );
+	    if ( ! w )
+	      w = e;
+	    addToWord( p, w - p, w - p );
+	    p = w;
 	  }
 	}
-	else // non WS		// remember in word
-	{
-	  if ( !_word )
-	    _word = it.pos();
-	  _wSize += it.size();
-	  _wColumns += it.columns();
-	}
+	text_r.remove_prefix( ascii );
+	if ( text_r.empty() )
+	  break;
+
+	// a multi-byte char, a control or an ANSI SGR
+	MbsIterator it( text_r );
+	if ( it.atEnd() )
+	  break;
+	if ( it.isNL() )
+	  gotoNextPar();	// write out any pending word and start new par
+	else if ( it.isWS() )
+	  addWS( leadingWSindents_r );
+	else
+	  addToWord( it.pos(), it.size(), it.columns() );
+	text_r.remove_prefix( it.size() );
       }
       writeout();		// write out any pending word; gaps are remembered for next text
     }
 
+    /** Handle a WS in \ref write. */
+    void addWS( bool leadingWSindents_r )
+    {
+      if ( _word )		// write out pending word and start new gap
+      {
+	writeout();
+	++_gap;
+      }
+      else
+      {
+	if ( atParBegin() && leadingWSindents_r )	// ws at par begin may increment indent
+	  ++_indentGap;
+	else
+	  ++_gap;
+      }
+    }
+
+    /** Remember non WS in word (\ref write). */
+    void addToWord( const char * pos_r, size_t size_r, size_t columns_r )
+    {
+      if ( !_word )
+	_word = pos_r;
+      _wSize += size_r;
+      _wColumns += columns_r;
+    }
+
     /** Write any pending "indent/gap+word" and reset for next word.
      * If \a force_r, gap is cleared even if no word is pending. This
      * is used before writing a '\n'.
@@ -609,12 +649,31 @@ inline void mbs_write_wrapped( std::ostream & out, boost::string_ref text_r, siz
 inline void mbs_write_wrapped( std::ostream & out, const zypp::str::Str & text_r, size_t indent_r, size_t wrap_r, int indentFix_r = 0 )
 { mbs_write_wrapped( out, text_r.str(), indent_r, wrap_r, indentFix_r ); }
 
+/** Whether \a text_r consists of printable ASCII chars only.
+ * Then it contains neither multi-byte chars nor ANSI SGR, and
+ * its column width is its size.
+ */
+inline bool mbs_is_printable_ascii( boost::string_ref text_r )
+{ return mbs::printableAsciiPrefix( text_r ) == text_r.size(); }
+
 /** Returns the column width of a multi-byte character string \a text_r */
 inline size_t mbs_width( boost::string_ref text_r )
 {
   size_t ret = 0;
-  for( mbs::MbsIterator it( text_r ); ! it.atEnd(); ++it )
+  while ( ! text_r.empty() )
+  {
+    size_t ascii = mbs::printableAsciiPrefix( text_r );
+    ret += ascii;
+    text_r.remove_prefix( ascii );
+    if ( text_r.empty() )
+      break;
+
+    mbs::MbsIterator it( text_r );	// a multi-byte char, a control or an ANSI SGR
+    if ( it.atEnd() )
+      break;
     ret += it.columns();
+    text_r.remove_prefix( it.size() );
+  }
   return ret;
 }
 
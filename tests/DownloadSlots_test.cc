@@ -0,0 +1,45 @@
+#include "TestSetup.h"
+#include "output/DownloadSlots.h"
+
+using out::DownloadSlots;
+
+BOOST_AUTO_TEST_CASE(slots)
+{
+  DownloadSlots slots;
+  BOOST_CHECK( slots.empty() );
+
+  slots.start( "http://a/x.rpm", "x.rpm" );
+  slots.start( "http://a/y.rpm", "y.rpm" );
+  BOOST_CHECK_EQUAL( slots.size(), 2 );
+  BOOST_CHECK( slots.update( "http://a/y.rpm", 50, 1000 ) );
+  BOOST_CHECK( ! slots.update( "http://a/z.rpm", 50, 1000 ) );
+  BOOST_CHECK_EQUAL( slots.slots()[1]._percent, 50 );
+
+  slots.finish( "http://a/x.rpm" );
+  BOOST_REQUIRE_EQUAL( slots.size(), 1 );
+  BOOST_CHECK_EQUAL( slots.slots()[0]._label, "y.rpm" );
+  slots.finish( "http://a/z.rpm" );	// not active
+  BOOST_CHECK_EQUAL( slots.size(), 1 );
+}
+
+BOOST_AUTO_TEST_CASE(aggregate)
+{
+  DownloadSlots slots;
+  DownloadSlots::Clock::time_point t0;
+  BOOST_CHECK_EQUAL( slots.totalRate(), -1 );
+  BOOST_CHECK_EQUAL( slots.eta( t0 ), -1 );
+
+  slots.start( "a", "a", t0 );
+  slots.start( "b", "b", t0 + std::chrono::seconds( 10 ) );
+  slots.start( "c", "c", t0 );
+  BOOST_CHECK_EQUAL( slots.totalRate(), -1 );
+
+  slots.update( "a", 50, 1000 );	// 20s elapsed: 20s left
+  slots.update( "b", 20, 500 );		// 10s elapsed: 40s left
+  BOOST_CHECK_EQUAL( slots.totalRate(), 1500 );
+  BOOST_CHECK_EQUAL( slots.eta( t0 + std::chrono::seconds( 20 ) ), 40 );
+
+  slots.finish( "b" );
+  BOOST_CHECK_EQUAL( slots.totalRate(), 1000 );
+  BOOST_CHECK_EQUAL( slots.eta( t0 + std::chrono::seconds( 20 ) ), 20 );
+}
@@ -0,0 +1,88 @@
+#include "TestSetup.h"
+#include "search.h"
+#include "Table.h"
+#include "utils/misc.h"
+
+#include <zypp/ResPoolProxy.h>
+
+extern ZYpp::Ptr God;
+
+struct TestInit {
+  TestInit()
+    : testSetup( std::make_unique<TestSetup>( Arch_x86_64 ) )
+  {
+    God = getZYpp();
+    testSetup->loadTargetRepo( TESTS_SRC_DIR "/data/openSUSE-11.1_subset" );
+    testSetup->loadRepo( TESTS_SRC_DIR "/data/openSUSE-11.1", "main" );
+    testSetup->loadRepo( TESTS_SRC_DIR "/data/openSUSE-11.1_updates", "upd" );
+  }
+
+  std::unique_ptr<TestSetup> testSetup;
+};
+BOOST_GLOBAL_FIXTURE( TestInit );
+
+namespace
+{
+  /** Output of list_packages on cout. */
+  std::string listPackages( ListPackagesFlags flags_r )
+  {
+    std::ostringstream str;
+    std::streambuf * coutbuf = cout.rdbuf( str.rdbuf() );
+    list_packages( Zypper::instance(), flags_r );
+    cout.rdbuf( coutbuf );
+    return str.str();
+  }
+
+  /** How 'zypper packages' used to build its table of all rows (no status checks). */
+  std::string tablePackages( ListPackagesFlags flags_r )
+  {
+    bool showInstalled = !flags_r.testFlag( ListPackagesBits::HideInstalled );
+    bool showUninstalled = !flags_r.testFlag( ListPackagesBits::HideNotInstalled );
+
+    Table tbl;
+    for ( const auto & sel : God->pool().proxy().byKind<Package>() )
+    {
+      if ( iType( sel ) ? ! showInstalled : ! showUninstalled )
+	continue;
+
+      for ( const auto & pi : sel->picklist() )
+      {
+	tbl << ( TableRow()
+	    << computeStatusIndicator( pi, sel )
+	    << pi->repository().info().name()
+	    << pi->name()
+	    << pi->edition().asString()
+	    << pi->arch().asString() );
+      }
+    }
+
+    tbl << ( TableHeader()
+	<< N_("S")
+	<< N_("Repository")
+	<< N_("Name")
+	<< table::EditionStyleSetter( tbl, N_("Version") )
+	<< N_("Arch") );
+
+    if ( flags_r.testFlag( ListPackagesBits::SortByRepo ) )
+      tbl.sort( 1 ); // Repo
+    else
+      tbl.sort( 2 ); // Name
+
+    std::ostringstream str;
+    str << tbl;
+    return str.str();
+  }
+}
+
+BOOST_AUTO_TEST_CASE(packages_output)
+{
+  for ( ListPackagesFlags flags : { ListPackagesFlags( ListPackagesBits::Default ),
+                                    ListPackagesFlags( ListPackagesBits::SortByRepo ),
+                                    ListPackagesFlags( ListPackagesBits::HideInstalled ),
+                                    ListPackagesBits::HideNotInstalled | ListPackagesBits::SortByRepo } )
+  {
+    std::string expected( tablePackages( flags ) );
+    BOOST_CHECK( expected.size() > 1000 );
+    BOOST_CHECK_EQUAL( listPackages( flags ), expected );
+  }
+}
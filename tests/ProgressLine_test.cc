@@ -0,0 +1,77 @@
+#include "TestSetup.h"
+#include "output/ProgressLine.h"
+
+#include <clocale>
+
+using out::ProgressLine;
+
+BOOST_AUTO_TEST_CASE(rate_limit)
+{
+  std::ostringstream str;
+  ProgressLine line( str, std::chrono::milliseconds( 100 ) );
+  ProgressLine::Clock::time_point t0;
+
+  BOOST_CHECK( line.due( t0 ) );	// nothing drawn yet
+  line.draw( "a", t0 );
+  BOOST_CHECK( ! line.due( t0 + std::chrono::milliseconds( 99 ) ) );
+  BOOST_CHECK( line.due( t0 + std::chrono::milliseconds( 100 ) ) );
+  line.reset();
+  BOOST_CHECK( line.due( t0 ) );
+}
+
+BOOST_AUTO_TEST_CASE(diff)
+{
+  std::ostringstream str;
+  ProgressLine line( str );
+
+  line.draw( "Retrieving: foo ---- [/]" );
+  BOOST_CHECK_EQUAL( str.str(), "\033[2K\rRetrieving: foo ---- [/]" );
+
+  str.str( "" );
+  line.draw( "Retrieving: foo ---- [/]" );	// unchanged
+  BOOST_CHECK_EQUAL( str.str(), "" );
+
+  str.str( "" );
+  line.draw( "Retrieving: foo .<5% [-]" );	// tail only
+  BOOST_CHECK_EQUAL( str.str(), "\r\033[16C.<5% [-]" );
+
+  str.str( "" );
+  line.draw( "Retrieving: foo" );		// shorter
+  BOOST_CHECK_EQUAL( str.str(), "\r\033[15C\033[K" );
+
+  str.str( "" );
+  line.draw( "Retrieving: f\xC3\xB6o" );	// not within a multibyte char
+  BOOST_CHECK_EQUAL( str.str(), "\r\033[13C\xC3\xB6o" );
+
+  str.str( "" );
+  line.draw( "Retrieving: f\xC3\xA4o" );
+  BOOST_CHECK_EQUAL( str.str(), "\r\033[13C\xC3\xA4o" );
+
+  str.str( "" );
+  line.draw( "\033[31mfoo\033[0m" );		// colored: complete
+  BOOST_CHECK_EQUAL( str.str(), "\033[2K\r\033[31mfoo\033[0m" );
+
+  str.str( "" );
+  line.reset();
+  line.draw( "\033[31mfoo\033[0m" );
+  BOOST_CHECK_EQUAL( str.str(), "\033[2K\r\033[31mfoo\033[0m" );
+}
+
+BOOST_AUTO_TEST_CASE(wide_chars)
+{
+  cout << "locale set to: " << setlocale (LC_CTYPE, "en_US.UTF-8") << endl;
+
+  std::ostringstream str;
+  ProgressLine line( str );
+
+  line.draw( "\xE4\xB8\x8B\xE8\xBD\xBD: foo [1%]" );	// '下载' 2 chars, 4 columns
+  str.str( "" );
+  line.draw( "\xE4\xB8\x8B\xE8\xBD\xBD: foo [2%]" );	// cursor right by columns
+  BOOST_CHECK_EQUAL( str.str(), "\r\033[11C2%]" );
+
+  line.reset();
+  line.draw( "x\xE5\x92\x8C\xE5\xB9\xB3\xE5\x92\x8C\xE5\xB9\xB3" );	// 'x和平和平' 5 chars, 9 columns
+  str.str( "" );
+  line.draw( "xabcdefg" );				// more chars but less columns
+  BOOST_CHECK_EQUAL( str.str(), "\r\033[1Cabcdefg\033[K" );
+}
@@ -416,6 +416,31 @@ BOOST_AUTO_TEST_CASE(install15)
   BOOST_CHECK(sr.toInstall().empty());
 }
 
+// request : install vim zypper / install vi[m] zyppe?
+// response: plain names are looked up in the pool's ident index, globs by
+//           a PoolQuery; both must select the same items
+BOOST_AUTO_TEST_CASE(install16)
+{
+  MIL << "<============install16===============>" << endl;
+
+  std::vector<std::string> plainargs;
+  plainargs.push_back("vim");
+  plainargs.push_back("zypper");
+  SolverRequester plain;
+  plain.install(plainargs);
+
+  std::vector<std::string> globargs;
+  globargs.push_back("vi[m]");
+  globargs.push_back("zyppe?");
+  SolverRequester glob;
+  glob.install(globargs);
+
+  BOOST_CHECK_EQUAL(plain.toInstall().size(), 2);
+  BOOST_CHECK(plain.toInstall() == glob.toInstall());
+  BOOST_CHECK(hasPoolItem(plain.toInstall(), "vim", Edition("7.2-7.4.1"), Arch_x86_64));
+  BOOST_CHECK(hasPoolItem(plain.toInstall(), "zypper", Edition("1.0.13-0.1.1"), Arch_x86_64));
+}
+
 
 ///////////////////////////////////////////////////////////////////////////
 // Locks
@@ -0,0 +1,219 @@
+#include "TestSetup.h"
+#include "Summary.h"
+
+#include <zypp/ResPoolProxy.h>
+#include <zypp/Patch.h>
+#include <zypp/Product.h>
+
+#include <set>
+
+struct TestInit {
+  TestInit()
+    : testSetup( std::make_unique<TestSetup>( Arch_x86_64 ) )
+  {
+    testSetup->loadTargetRepo( TESTS_SRC_DIR "/data/openSUSE-11.1_subset" );
+    testSetup->loadRepo( TESTS_SRC_DIR "/data/openSUSE-11.1", "main" );	// packages and the product
+    testSetup->loadRepo( TESTS_SRC_DIR "/data/openSUSE-11.1_updates", "upd" );	// updates and patches
+
+    // resolve pool so that the satisfied status of pseudo-installed kinds becomes known
+    getZYpp()->resolver()->resolvePool();
+  }
+
+  std::unique_ptr<TestSetup> testSetup;
+};
+BOOST_GLOBAL_FIXTURE( TestInit );
+
+namespace
+{
+  typedef std::set<std::string> Names;
+
+  std::string asEntry( const ResKind & kind_r, const std::string & name_r, const std::string & edition_r, const std::string & arch_r )
+  { return kind_r.asString() + ":" + name_r + "-" + edition_r + "." + arch_r; }
+
+  std::string asEntry( const PoolItem & pi_r )
+  { return asEntry( pi_r.kind(), pi_r.name(), pi_r.edition().asString(), pi_r.arch().asString() ); }
+
+  /** The value of attribute \a attr_r in an XML line. */
+  std::string attr( const std::string & line_r, const std::string & attr_r )
+  {
+    std::string::size_type pos = line_r.find( " " + attr_r + "=\"" );
+    if ( pos == std::string::npos )
+      return std::string();
+    pos += attr_r.size() + 3;
+    return line_r.substr( pos, line_r.find( '"', pos ) - pos );
+  }
+
+  /** The solvables listed in the <tag_r> section of the XML summary. */
+  Names section( const std::string & xml_r, const std::string & tag_r )
+  {
+    Names ret;
+    std::string::size_type begin = xml_r.find( "<" + tag_r + ">" );
+    if ( begin == std::string::npos )
+      return ret;
+    std::istringstream str( xml_r.substr( begin, xml_r.find( "</" + tag_r + ">" ) - begin ) );
+    std::string line;
+    while ( std::getline( str, line ) )
+    {
+      if ( str::startsWith( line, "<solvable " ) )
+	ret.insert( asEntry( ResKind( attr( line, "type" ) ), attr( line, "name" ), attr( line, "edition" ), attr( line, "arch" ) ) );
+    }
+    return ret;
+  }
+
+  std::string xmlSummary( Summary & summary_r )
+  {
+    std::ostringstream str;
+    summary_r.dumpAsXmlTo( str );
+    return str.str();
+  }
+
+  void resetTransact()
+  {
+    for ( const PoolItem & pi : ResPool::instance() )
+      pi.status().resetTransact( ResStatus::USER );
+  }
+
+  /** A patch suggesting a reboot (or just a restart of the package manager). */
+  PoolItem patch( bool reboot_r )
+  {
+    for ( const PoolItem & pi : ResPool::instance().byKind<Patch>() )
+    {
+      Patch::constPtr patch( pi->asKind<Patch>() );
+      if ( reboot_r ? patch->rebootSuggested() : ( patch->restartSuggested() && ! patch->rebootSuggested() ) )
+	return pi;
+    }
+    BOOST_FAIL( "no such patch" );
+    return PoolItem();
+  }
+
+  /** The transaction set up by \ref setupTransaction. */
+  struct Expected
+  {
+    Names _install;
+    Names _upgrade;
+    Names _reinstall;
+    Names _remove;
+  };
+
+  /** Install, upgrade, reinstall and remove some packages, install patches and the product. */
+  Expected setupTransaction( const std::vector<PoolItem> & patches_r )
+  {
+    Expected ret;
+    PoolItem newinstall, upgrade, reinstall, remove;
+
+    for ( const ui::Selectable::Ptr & sel : ResPool::instance().proxy().byKind<Package>() )
+    {
+      if ( sel->multiversionInstall() )
+	continue;
+
+      PoolItem installed( sel->installedObj() );
+      PoolItem candidate( sel->highestAvailableVersionObj() );
+      if ( ! installed )
+      {
+	if ( ! newinstall && candidate )
+	  newinstall = candidate;
+      }
+      else if ( ! upgrade && candidate
+	        && candidate.edition() > installed.edition() && candidate.arch() == installed.arch() )
+	upgrade = candidate;
+      else if ( ! reinstall && sel->identicalAvailableObj( installed ) )
+	reinstall = sel->identicalAvailableObj( installed );
+      else if ( ! remove )
+	remove = installed;
+    }
+    BOOST_REQUIRE( newinstall && upgrade && reinstall && remove );
+
+    newinstall.status().setToBeInstalled( ResStatus::USER );
+    ret._install.insert( asEntry( newinstall ) );
+
+    upgrade.status().setToBeInstalled( ResStatus::USER );
+    ui::Selectable::get( upgrade )->installedObj().status().setToBeUninstalled( ResStatus::USER );
+    ret._upgrade.insert( asEntry( upgrade ) );
+
+    reinstall.status().setToBeInstalled( ResStatus::USER );
+    ui::Selectable::get( reinstall )->installedObj().status().setToBeUninstalled( ResStatus::USER );
+    ret._reinstall.insert( asEntry( reinstall ) );
+
+    remove.status().setToBeUninstalled( ResStatus::USER );
+    ret._remove.insert( asEntry( remove ) );
+
+    for ( const PoolItem & pi : patches_r )
+    {
+      BOOST_REQUIRE( pi.status().setToBeInstalled( ResStatus::USER ) );
+      ret._install.insert( asEntry( pi ) );
+    }
+
+    PoolItem product;
+    for ( const ui::Selectable::Ptr & sel : ResPool::instance().proxy().byKind<Product>() )
+    {
+      if ( ! sel->hasInstalledObj() && sel->highestAvailableVersionObj() )
+      {
+	product = sel->highestAvailableVersionObj();
+	break;
+      }
+    }
+    BOOST_REQUIRE( product );
+    BOOST_REQUIRE( product.status().setToBeInstalled( ResStatus::USER ) );
+    ret._install.insert( asEntry( product ) );
+
+    // the whole pool's view
+    Names transacting;
+    for ( const PoolItem & pi : ResPool::instance() )
+      if ( pi.status().transacts() )
+	transacting.insert( asEntry( pi ) );
+    BOOST_CHECK_EQUAL( transacting.size(), ret._install.size() + 2 * ret._upgrade.size() + 2 * ret._reinstall.size() + ret._remove.size() );
+    return ret;
+  }
+}
+
+BOOST_AUTO_TEST_CASE(nothing_to_do)
+{
+  resetTransact();
+  Summary summary( ResPool::instance() );
+  BOOST_CHECK_EQUAL( summary.packagesToInstall(), 0 );
+  BOOST_CHECK_EQUAL( summary.packagesToRemove(), 0 );
+  BOOST_CHECK( ! summary.needMachineReboot() );
+  BOOST_CHECK( ! summary.needPkgMgrRestart() );
+  BOOST_CHECK( section( xmlSummary( summary ), "to-install" ).empty() );
+}
+
+BOOST_AUTO_TEST_CASE(lists_and_restart)
+{
+  resetTransact();
+  Expected expected( setupTransaction( { patch( false ) } ) );
+
+  Summary summary( ResPool::instance() );
+  const std::string xml( xmlSummary( summary ) );
+  BOOST_CHECK( section( xml, "to-install" ) == expected._install );
+  BOOST_CHECK( section( xml, "to-upgrade" ) == expected._upgrade );
+  BOOST_CHECK( section( xml, "to-reinstall" ) == expected._reinstall );
+  BOOST_CHECK( section( xml, "to-remove" ) == expected._remove );
+  BOOST_CHECK( section( xml, "to-downgrade" ).empty() );
+
+  BOOST_CHECK_EQUAL( summary.packagesToInstall(), 1 );
+  BOOST_CHECK_EQUAL( summary.packagesToUpgrade(), 1 );
+  BOOST_CHECK_EQUAL( summary.packagesToReInstall(), 1 );
+  BOOST_CHECK_EQUAL( summary.packagesToRemove(), 1 );
+  BOOST_CHECK_EQUAL( summary.packagesToGetAndInstall(), 3 );
+
+  BOOST_CHECK( ! summary.needMachineReboot() );
+  BOOST_CHECK( summary.needPkgMgrRestart() );
+}
+
+BOOST_AUTO_TEST_CASE(reboot)
+{
+  resetTransact();
+  Expected expected( setupTransaction( { patch( true ), patch( false ) } ) );
+
+  Summary summary( ResPool::instance() );
+  const std::string xml( xmlSummary( summary ) );
+  BOOST_CHECK( section( xml, "to-install" ) == expected._install );
+  BOOST_CHECK( section( xml, "to-upgrade" ) == expected._upgrade );
+  BOOST_CHECK( section( xml, "to-remove" ) == expected._remove );
+  BOOST_CHECK( attr( xml, "need-reboot" ) == "1" );
+
+  BOOST_CHECK( summary.needMachineReboot() );
+  BOOST_CHECK( summary.needPkgMgrRestart() );
+
+  resetTransact();
+}
@@ -0,0 +1,325 @@
+#include "TestSetup.h"
+#include "Table.h"
+
+#include <clocale>
+
+namespace
+{
+  std::string dump( const Table & table_r )
+  {
+    std::ostringstream str;
+    str << table_r;
+    return str.str();
+  }
+
+  void addRow( Table & table_r, std::initializer_list<const char *> cols_r, unsigned userData_r )
+  {
+    TableRow row;
+    for ( const char * col : cols_r )
+      row << col;
+    row.userData( userData_r );
+    table_r << std::move(row);
+  }
+
+  /** Rows of different length and some equal values to sort. */
+  Table sortTable()
+  {
+    Table t;
+    addRow( t, { "b", "2", "x" },	3 );
+    addRow( t, { "a", "2" },		2 );
+    addRow( t, { "c", "1" },		1 );
+    addRow( t, { "a", "1", "y" },	4 );
+    addRow( t, { "b", "2" },		1 );
+    addRow( t, { "a" },			5 );
+    return t;
+  }
+}
+
+BOOST_AUTO_TEST_CASE(column_widths)
+{
+  Table t;
+  t << ( TableHeader() << "S" << "Name" << "Version" );
+  t << ( TableRow() << "i" << "zypper" << "1.14.0-1" );
+  t << ( TableRow() << "" << "libzypp" << "17.0" );
+  t << ( TableRow() << "i" << "x" );
+
+  BOOST_CHECK_EQUAL( dump( t ),
+		     "S | Name    | Version\n"
+		     "--+---------+---------\n"
+		     "i | zypper  | 1.14.0-1\n"
+		     "  | libzypp | 17.0\n"
+		     "i | x\n" );
+
+  t.lineStyle( none );
+  BOOST_CHECK_EQUAL( dump( t ),
+		     "S  Name     Version\n"
+		     "                      \n"
+		     "i  zypper   1.14.0-1\n"
+		     "   libzypp  17.0\n"
+		     "i  x\n" );
+}
+
+BOOST_AUTO_TEST_CASE(column_widths_multibyte)
+{
+  BOOST_REQUIRE( setlocale( LC_CTYPE, "en_US.UTF-8" ) || setlocale( LC_CTYPE, "C.UTF-8" ) );
+
+  Table t;
+  t << ( TableHeader() << "Name" << "Version" );
+  t << ( TableRow() << "\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e" << "1" );	// 3 double width chars
+  t << ( TableRow() << "zypper" << "1.14.0" );
+
+  BOOST_CHECK_EQUAL( dump( t ),
+		     "Name   | Version\n"
+		     "-------+--------\n"
+		     "\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e | 1\n"
+		     "zypper | 1.14.0\n" );
+}
+
+BOOST_AUTO_TEST_CASE(wrapping)
+{
+  // Not on a terminal there is no screen width, so every column
+  // after the forced break is wrapped.
+  Table t;
+  t << ( TableHeader() << "Name" << "Summary" << "Repo" );
+  t << ( TableRow() << "zypper" << "Command line package manager" << "main" );
+  t << ( TableRow() << "libzypp" << "Package management library" << "main" );
+  t.wrap( 1 );
+
+  BOOST_CHECK_EQUAL( dump( t ),
+		     "Name   \n"
+		     "  Summary                     \n"
+		     "  Repo\n"
+		     "--------+------------------------------+-----\n"
+		     "zypper \n"
+		     "  Command line package manager\n"
+		     "  main\n"
+		     "libzypp\n"
+		     "  Package management library  \n"
+		     "  main\n" );
+
+  Table d;
+  d << ( TableRow() << "a" << "b" );
+  d.lastRow().addDetail( "detail line" );
+  d << ( TableRow() << "c" << "d" );
+  BOOST_CHECK_EQUAL( dump( d ),
+		     "a | b\n"
+		     "    detail line\n"
+		     "c | d\n" );
+}
+
+BOOST_AUTO_TEST_CASE(sort_by_columns)
+{
+  Table t( sortTable() );
+
+  t.sort( 0 );
+  BOOST_CHECK_EQUAL( dump( t ),
+		     "a | 2\n"
+		     "a | 1 | y\n"
+		     "a\n"
+		     "b | 2 | x\n"
+		     "b | 2\n"
+		     "c | 1\n" );
+
+  t.sort( { 1, 0 } );	// rows lacking a column first
+  BOOST_CHECK_EQUAL( dump( t ),
+		     "a\n"
+		     "a | 1 | y\n"
+		     "c | 1\n"
+		     "a | 2\n"
+		     "b | 2 | x\n"
+		     "b | 2\n" );
+
+  t.sort( { 2, Table::UserData } );	// rows lacking a column by UserData
+  BOOST_CHECK_EQUAL( dump( t ),
+		     "c | 1\n"
+		     "b | 2\n"
+		     "a | 2\n"
+		     "a\n"
+		     "b | 2 | x\n"
+		     "a | 1 | y\n" );
+
+  t.sort( Table::UserData );
+  BOOST_CHECK_EQUAL( dump( t ),
+		     "c | 1\n"
+		     "b | 2\n"
+		     "a | 2\n"
+		     "b | 2 | x\n"
+		     "a | 1 | y\n"
+		     "a\n" );
+
+  t.sort( Table::Unsorted );	// no change
+  BOOST_CHECK_EQUAL( dump( t ).substr( 0, 12 ), "c | 1\nb | 2\n" );
+}
+
+BOOST_AUTO_TEST_CASE(custom_sort)
+{
+  static const std::string expected(
+    "b | 2 | x\n"
+    "a | 1 | y\n"
+    "a | 2\n"
+    "c | 1\n"
+    "b | 2\n"
+    "a\n" );
+
+  Table t( sortTable() );
+  t.sort( []( const Table::RowRef & lhs, const Table::RowRef & rhs ) { return lhs.size() > rhs.size(); } );
+  BOOST_CHECK_EQUAL( dump( t ), expected );
+
+  Table tr( sortTable() );
+  tr.sort( []( const TableRow & lhs, const TableRow & rhs ) { return lhs.size() > rhs.size(); } );
+  BOOST_CHECK_EQUAL( dump( tr ), expected );
+}
+
+BOOST_AUTO_TEST_CASE(rows)
+{
+  Table t( sortTable() );
+  t.sort( 0 );
+
+  const Table::Rows & rows( t.rows() );
+  BOOST_REQUIRE_EQUAL( rows.size(), 6 );
+  BOOST_CHECK_EQUAL( rows[0][0], "a" );
+  BOOST_CHECK_EQUAL( rows[0][1], "2" );
+  BOOST_CHECK_EQUAL( rows[0][2], "" );		// missing column
+  BOOST_CHECK_EQUAL( rows[1].size(), 3 );
+  BOOST_CHECK_EQUAL( boost::any_cast<unsigned>( rows[1].userData() ), 4 );
+
+  TableRow row( rows[3].tableRow() );
+  BOOST_CHECK( row.columns() == TableRow::container({ "b", "2", "x" }) );
+  BOOST_CHECK_EQUAL( boost::any_cast<unsigned>( row.userData() ), 3 );
+}
+
+BOOST_AUTO_TEST_CASE(last_row)
+{
+  Table t;
+  BOOST_CHECK_THROW( t.lastRow(), zypp::Exception );
+  BOOST_CHECK_THROW( t.row( 0 ), zypp::Exception );
+
+  t = sortTable();
+  t.sort( 0 );
+  // the row added last keeps its place in the sorted table
+  t.lastRow().addDetail( "last" );
+  t.lastRow() << "z";
+  BOOST_CHECK_EQUAL( dump( t ),
+		     "a | 2\n"
+		     "a | 1 | y\n"
+		     "a | z\n"
+		     "    last\n"
+		     "b | 2 | x\n"
+		     "b | 2\n"
+		     "c | 1\n" );
+
+  // any row by its display position
+  t.row( 4 ).columns()[1] = "3";
+  t.row( 0 ) << "w";
+  BOOST_CHECK_THROW( t.row( 6 ), zypp::Exception );
+  BOOST_CHECK_EQUAL( dump( t ),
+		     "a | 2 | w\n"
+		     "a | 1 | y\n"
+		     "a | z\n"
+		     "    last\n"
+		     "b | 2 | x\n"
+		     "b | 3\n"
+		     "c | 1\n" );
+
+  t.sort( { 1, 0 } );
+  BOOST_CHECK_EQUAL( dump( t ),
+		     "a | 1 | y\n"
+		     "c | 1\n"
+		     "a | 2 | w\n"
+		     "b | 2 | x\n"
+		     "b | 3\n"
+		     "a | z\n"
+		     "    last\n" );
+}
+
+BOOST_AUTO_TEST_CASE(sort_keys_like_less)
+{
+  // The Table sorts by precomputed keys; TableRow::Less is the reference.
+  std::vector<TableRow> rows;
+  unsigned rnd = 4711;
+  auto next = [&rnd]( unsigned mod_r ) { rnd = rnd * 1103515245 + 12345; return ( rnd >> 16 ) % mod_r; };
+  static const char * values[] = { "", "a", "A", "b", "ab", "aa", "b-1", "\xc3\xa4" };
+  for ( unsigned i = 0; i < 300; ++i )
+  {
+    TableRow row;
+    for ( unsigned c = next( 5 ); c; --c )
+      row << values[next( 8 )];
+    if ( next( 4 ) )
+      row.userData( next( 6 ) );
+    rows.push_back( std::move(row) );
+  }
+
+  Table t;
+  for ( const TableRow & row : rows )
+    t << row;
+
+  const std::vector<std::list<unsigned>> byColumns {
+    { 0 }, { 1, 0 }, { 2, Table::UserData }, { Table::UserData }, { 3, 1 }, { 0, 1, 2, 3 }, { 5 }
+  };
+  for ( const std::list<unsigned> & by : byColumns )
+  {
+    // successive sorts: both start from the previous order
+    t.sort( by );
+    std::stable_sort( rows.begin(), rows.end(), TableRow::Less( by ) );
+
+    const Table::Rows & trows( t.rows() );
+    BOOST_REQUIRE_EQUAL( trows.size(), rows.size() );
+    for ( unsigned i = 0; i < rows.size(); ++i )
+    {
+      TableRow row( trows[i].tableRow() );
+      BOOST_REQUIRE( row.columns() == rows[i].columns() );
+      BOOST_REQUIRE( row.userData().empty() == rows[i].userData().empty() );
+      if ( ! row.userData().empty() )
+	BOOST_REQUIRE_EQUAL( boost::any_cast<unsigned>( row.userData() ), boost::any_cast<unsigned>( rows[i].userData() ) );
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(streaming_table)
+{
+  const std::vector<std::vector<std::string>> data {
+    { "i", "repo-a", "zypper", "1.14.0-1", "x86_64" },
+    { "", "Repo with long name", "libzypp", "17", "noarch" },
+    { "v", "r", "x", "1.0-1.1.1.1.1", "i586" },
+  };
+  auto header = []( Table & table_r ) {
+    return TableHeader() << "S" << "Repository" << "Name" << table::EditionStyleSetter( table_r, "Version" ) << "Arch";
+  };
+  auto row = []( const std::vector<std::string> & cols_r ) {
+    TableRow ret;
+    for ( const std::string & col : cols_r )
+      ret << col;
+    return ret;
+  };
+
+  Table t;
+  t << header( t );
+  for ( const auto & cols : data )
+    t << row( cols );
+  const std::string expected( dump( t ) );
+
+  // measuring rows
+  std::ostringstream rows;
+  {
+    StreamingTable stbl( rows );
+    stbl.table() << header( stbl.table() );
+    for ( const auto & cols : data )
+      stbl.measure( row( cols ) );
+    for ( const auto & cols : data )
+      stbl.print( row( cols ) );
+  }
+  BOOST_CHECK_EQUAL( rows.str(), expected );
+
+  // measuring cells before the header is set
+  std::ostringstream cells;
+  {
+    StreamingTable stbl( cells );
+    for ( const auto & cols : data )
+      for ( unsigned c = 0; c < cols.size(); ++c )
+	stbl.measure( c, cols[c] );
+    stbl.table() << header( stbl.table() );
+    for ( const auto & cols : data )
+      stbl.print( row( cols ) );
+  }
+  BOOST_CHECK_EQUAL( cells.str(), expected );
+}
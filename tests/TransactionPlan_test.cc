@@ -0,0 +1,278 @@
+#include "TestSetup.h"
+#include "TransactionPlan.h"
+
+#include <zypp/ResPoolProxy.h>
+
+#include <algorithm>
+#include <set>
+#include <sstream>
+
+namespace
+{
+  TestSetup * testSetup = nullptr;	// the global fixture's, to load more repos
+
+  struct TestInit {
+    TestInit()
+      : _testSetup( std::make_unique<TestSetup>( Arch_x86_64 ) )
+    {
+      testSetup = _testSetup.get();
+      testSetup->loadTargetRepo( TESTS_SRC_DIR "/data/openSUSE-11.1_subset" );
+      testSetup->loadRepo( TESTS_SRC_DIR "/data/openSUSE-11.1", "main" );
+    }
+    std::unique_ptr<TestSetup> _testSetup;
+  };
+
+  void resetTransact()
+  {
+    for ( const PoolItem & pi : ResPool::instance() )
+    {
+      pi.status().resetTransact( ResStatus::USER );
+      pi.status().setLock( false, ResStatus::USER );
+    }
+  }
+
+  /** The transacting items and their causer. */
+  std::set<std::string> transaction()
+  {
+    std::set<std::string> ret;
+    for ( const PoolItem & pi : ResPool::instance() )
+    {
+      if ( pi.status().transacts() )
+	ret.insert( str::Str() << ( pi.status().isToBeInstalled() ? "+ " : "- " ) << pi.satSolvable()
+				<< ( pi.status().isByUser() ? " user" : " solver" ) );
+    }
+    return ret;
+  }
+
+  PoolItem installedPackage()
+  {
+    for ( const ui::Selectable::Ptr & sel : ResPool::instance().proxy().byKind<Package>() )
+      if ( sel->hasInstalledObj() )
+	return sel->installedObj();
+    BOOST_FAIL( "no installed package" );
+    return PoolItem();
+  }
+
+  PoolItem uninstalledPackage()
+  {
+    for ( const ui::Selectable::Ptr & sel : ResPool::instance().proxy().byKind<Package>() )
+      if ( ! sel->hasInstalledObj() && sel->candidateObj() )
+	return sel->candidateObj();
+    BOOST_FAIL( "no uninstalled package" );
+    return PoolItem();
+  }
+
+  /** A one step plan installing or removing \a pi_r. */
+  TransactionPlan planFor( const PoolItem & pi_r )
+  {
+    resetTransact();
+    BOOST_REQUIRE( pi_r.status().isInstalled() ? pi_r.status().setToBeUninstalled( ResStatus::USER )
+					       : pi_r.status().setToBeInstalled( ResStatus::USER ) );
+    TransactionPlan ret( TransactionPlan::fromPool( ResPool::instance() ) );
+    resetTransact();
+    BOOST_REQUIRE_EQUAL( ret.steps().size(), 1 );
+    return ret;
+  }
+
+  inline bool mentions( const std::string & problem_r, const PoolItem & pi_r )
+  { return problem_r.find( pi_r.name() + "-" + pi_r.edition().asString() + "." + pi_r.arch().asString() ) != std::string::npos; }
+}
+BOOST_GLOBAL_FIXTURE( TestInit );
+
+BOOST_AUTO_TEST_CASE(roundtrip)
+{
+  TransactionPlan plan;
+  plan.setFingerprint( "0123abcd" );
+
+  TransactionPlan::Step step;
+  step._kind = "package";
+  step._name = "vim";
+  step._edition = "9.0.1-1.1";
+  step._arch = "x86_64";
+  step._repo = "repo oss";	// aliases may contain blanks
+  step._checksum = "sha256:4f3c";
+  plan.addStep( step );
+
+  step._action = TransactionPlan::Step::Remove;
+  step._edition = "8.2.4-1.1";
+  step._causer = TransactionPlan::Step::Solver;
+  step._repo = "@System";
+  step._checksum.clear();
+  plan.addStep( step );
+
+  std::stringstream str;
+  plan.write( str );
+  TransactionPlan read( TransactionPlan::read( str ) );
+
+  BOOST_CHECK_EQUAL( read.fingerprint(), "0123abcd" );
+  BOOST_REQUIRE_EQUAL( read.steps().size(), 2 );
+  BOOST_CHECK( read.steps()[0]._action == TransactionPlan::Step::Install );
+  BOOST_CHECK( read.steps()[0]._causer == TransactionPlan::Step::User );
+  BOOST_CHECK_EQUAL( read.steps()[0]._repo, "repo oss" );
+  BOOST_CHECK_EQUAL( read.steps()[0]._checksum, "sha256:4f3c" );
+  BOOST_CHECK( read.steps()[1]._action == TransactionPlan::Step::Remove );
+  BOOST_CHECK( read.steps()[1]._causer == TransactionPlan::Step::Solver );
+  BOOST_CHECK_EQUAL( read.steps()[1]._edition, "8.2.4-1.1" );
+  BOOST_CHECK_EQUAL( read.steps()[1]._checksum, "" );
+}
+
+BOOST_AUTO_TEST_CASE(malformed)
+{
+  std::istringstream nofingerprint( "# zypper transaction plan\n" );
+  BOOST_CHECK_THROW( TransactionPlan::read( nofingerprint ), zypp::Exception );
+
+  std::istringstream badline( "fingerprint\t0123abcd\nupgrade\tpackage\tvim\n" );
+  BOOST_CHECK_THROW( TransactionPlan::read( badline ), zypp::Exception );
+
+  std::istringstream shortline( "fingerprint\t0123abcd\ninstall\tpackage\tvim\t9.0.1-1.1\tx86_64\n" );
+  BOOST_CHECK_THROW( TransactionPlan::read( shortline ), zypp::Exception );
+
+  std::istringstream badcauser( "fingerprint\t0123abcd\ninstall\tpackage\tvim\t9.0.1-1.1\tx86_64\toss\t\tadmin\n" );
+  BOOST_CHECK_THROW( TransactionPlan::read( badcauser ), zypp::Exception );
+}
+
+BOOST_AUTO_TEST_CASE(no_causer)
+{
+  // plans written without the causer field
+  std::istringstream str( "fingerprint\t0123abcd\n"
+			  "install\tpackage\tvim\t9.0.1-1.1\tx86_64\toss\tsha256:4f3c\n"
+			  "remove\tpackage\tvim\t8.2.4-1.1\tx86_64\t@System\n" );
+  TransactionPlan read( TransactionPlan::read( str ) );
+  BOOST_REQUIRE_EQUAL( read.steps().size(), 2 );
+  BOOST_CHECK( read.steps()[0]._causer == TransactionPlan::Step::User );
+  BOOST_CHECK_EQUAL( read.steps()[0]._checksum, "sha256:4f3c" );
+  BOOST_CHECK( read.steps()[1]._causer == TransactionPlan::Step::User );
+}
+
+BOOST_AUTO_TEST_CASE(apply_causer)
+{
+  // a user install pulling in dependencies
+  ResPool pool( ResPool::instance() );
+  bool solverSteps = false;
+  for ( const ui::Selectable::Ptr & sel : pool.proxy().byKind<Package>() )
+  {
+    if ( sel->hasInstalledObj() || ! sel->candidateObj() )
+      continue;
+    resetTransact();
+    sel->candidateObj().status().setToBeInstalled( ResStatus::USER );
+    if ( getZYpp()->resolver()->resolvePool() && transaction().size() > 1 )
+    {
+      solverSteps = true;
+      break;
+    }
+  }
+  BOOST_REQUIRE( solverSteps );
+  const std::set<std::string> expected( transaction() );
+
+  TransactionPlan saved( TransactionPlan::fromPool( pool ) );
+  BOOST_CHECK_EQUAL( saved.steps().size(), expected.size() );
+  BOOST_CHECK_EQUAL( std::count_if( saved.steps().begin(), saved.steps().end(),
+				    []( const TransactionPlan::Step & step_r ) { return step_r._causer == TransactionPlan::Step::User; } ), 1 );
+
+  std::stringstream str;
+  saved.write( str );
+  TransactionPlan plan( TransactionPlan::read( str ) );
+
+  resetTransact();
+  std::vector<std::string> problems;
+  BOOST_CHECK( plan.apply( pool, problems ) );
+  BOOST_CHECK( problems.empty() );
+  BOOST_CHECK( transaction() == expected );
+  resetTransact();
+}
+
+BOOST_AUTO_TEST_CASE(apply_missing)
+{
+  PoolItem pi( uninstalledPackage() );
+  const TransactionPlan::Step step( planFor( pi ).steps()[0] );
+
+  TransactionPlan plan;
+  TransactionPlan::Step missing( step );
+  missing._name = "nosuchpackage";
+  plan.addStep( missing );
+  missing = step;
+  missing._edition = "0.0.1-1";
+  plan.addStep( missing );
+  missing = step;
+  missing._repo = "nosuchrepo";
+  plan.addStep( missing );
+  plan.addStep( step );
+
+  std::vector<std::string> problems;
+  BOOST_CHECK( ! plan.apply( ResPool::instance(), problems ) );
+  BOOST_REQUIRE_EQUAL( problems.size(), 3 );
+  BOOST_CHECK( problems[0].find( "nosuchpackage-" ) != std::string::npos );
+  BOOST_CHECK( problems[1].find( "-0.0.1-1." ) != std::string::npos );
+  BOOST_CHECK( problems[2].find( "nosuchrepo" ) != std::string::npos );
+  // the steps found are applied anyway
+  BOOST_CHECK( pi.status().isToBeInstalled() );
+  resetTransact();
+}
+
+BOOST_AUTO_TEST_CASE(apply_checksum_mismatch)
+{
+  PoolItem pi( uninstalledPackage() );
+  TransactionPlan plan( planFor( pi ) );
+
+  TransactionPlan::Step step( plan.steps()[0] );
+  step._checksum = "sha256:0123abcd";
+  TransactionPlan changed;
+  changed.addStep( step );
+
+  std::vector<std::string> problems;
+  BOOST_CHECK( ! changed.apply( ResPool::instance(), problems ) );
+  BOOST_REQUIRE_EQUAL( problems.size(), 1 );
+  BOOST_CHECK( mentions( problems[0], pi ) );
+  BOOST_CHECK( ! pi.status().transacts() );
+
+  problems.clear();
+  BOOST_CHECK( plan.apply( ResPool::instance(), problems ) );
+  BOOST_CHECK( pi.status().isToBeInstalled() && pi.status().isByUser() );
+  resetTransact();
+}
+
+BOOST_AUTO_TEST_CASE(apply_locked)
+{
+  PoolItem install( uninstalledPackage() );
+  PoolItem remove( installedPackage() );
+  TransactionPlan plan( planFor( install ) );
+  plan.addStep( planFor( remove ).steps()[0] );
+  TransactionPlan::Step bySolver( plan.steps()[0] );
+  bySolver._causer = TransactionPlan::Step::Solver;
+  plan.addStep( bySolver );
+
+  install.status().setLock( true, ResStatus::USER );
+  remove.status().setLock( true, ResStatus::USER );
+  std::vector<std::string> problems;
+  BOOST_CHECK( ! plan.apply( ResPool::instance(), problems ) );
+  BOOST_REQUIRE_EQUAL( problems.size(), 3 );
+  BOOST_CHECK( mentions( problems[0], install ) );
+  BOOST_CHECK( mentions( problems[1], remove ) );
+  BOOST_CHECK( mentions( problems[2], install ) );
+  BOOST_CHECK( ! install.status().transacts() );
+  BOOST_CHECK( ! remove.status().transacts() );
+  resetTransact();
+}
+
+// last, it loads another repo
+BOOST_AUTO_TEST_CASE(pool_fingerprint)
+{
+  ResPool pool( ResPool::instance() );
+  resetTransact();
+  const std::string fingerprint( TransactionPlan::poolFingerprint( pool ) );
+  BOOST_CHECK_EQUAL( fingerprint.size(), 64 );	// sha256
+  BOOST_CHECK_EQUAL( TransactionPlan::poolFingerprint( pool ), fingerprint );
+
+  // the transaction and locks are not part of it
+  uninstalledPackage().status().setToBeInstalled( ResStatus::USER );
+  installedPackage().status().setLock( true, ResStatus::USER );
+  BOOST_CHECK_EQUAL( TransactionPlan::poolFingerprint( pool ), fingerprint );
+  BOOST_CHECK_EQUAL( TransactionPlan::fromPool( pool ).fingerprint(), fingerprint );
+  resetTransact();
+
+  // the repos are
+  testSetup->loadRepo( TESTS_SRC_DIR "/data/openSUSE-11.1_updates", "upd" );
+  const std::string withUpdates( TransactionPlan::poolFingerprint( pool ) );
+  BOOST_CHECK_EQUAL( withUpdates.size(), 64 );
+  BOOST_CHECK_NE( withUpdates, fingerprint );
+}
@@ -0,0 +1,104 @@
+#include "TestSetup.h"
+#include "utils/FuzzyNameIndex.h"
+#include "utils/misc.h"
+
+#include <algorithm>
+#include <vector>
+
+using Names = std::vector<std::string>;
+
+BOOST_AUTO_TEST_CASE(distance)
+{
+  BOOST_CHECK_EQUAL( FuzzyNameIndex::distance( "kitten", "sitting", 3 ),	3 );
+  BOOST_CHECK_EQUAL( FuzzyNameIndex::distance( "kitten", "sitting", 2 ),	3 );	// exceeds max: max+1
+  BOOST_CHECK_EQUAL( FuzzyNameIndex::distance( "sitting", "kitten", 5 ),	3 );
+  BOOST_CHECK_EQUAL( FuzzyNameIndex::distance( "", "ab", 2 ),		2 );
+  BOOST_CHECK_EQUAL( FuzzyNameIndex::distance( "abc", "abcdef", 2 ),	3 );	// length differs too much
+  BOOST_CHECK_EQUAL( FuzzyNameIndex::distance( "ZYPPER", "zypper", 0 ),	0 );	// ASCII case-insensitive
+  BOOST_CHECK_EQUAL( FuzzyNameIndex::distance( "abcdef", "badcfe", 1 ),	2 );	// early termination
+  BOOST_CHECK_EQUAL( FuzzyNameIndex::distance( "abcdef", "badcfe", 6 ),	4 );
+}
+
+BOOST_AUTO_TEST_CASE(distance_band)
+{
+  // the banded computation must agree with the full one within the limit
+  auto full = []( const std::string & lhs, const std::string & rhs ) {
+    std::vector<unsigned> prev( rhs.size()+1 ), curr( rhs.size()+1 );
+    for ( size_t j = 0; j <= rhs.size(); ++j )
+      prev[j] = j;
+    for ( size_t i = 1; i <= lhs.size(); ++i )
+    {
+      curr[0] = i;
+      for ( size_t j = 1; j <= rhs.size(); ++j )
+	curr[j] = std::min( { prev[j-1] + ( lhs[i-1] == rhs[j-1] ? 0 : 1 ), prev[j] + 1, curr[j-1] + 1 } );
+      std::swap( prev, curr );
+    }
+    return prev[rhs.size()];
+  };
+
+  const Names words { "", "a", "ab", "ba", "abc", "zypper", "zypp", "libzypp", "yast2", "ypper", "zyppre", "kernel-default", "kernel-devel" };
+  for ( const std::string & lhs : words )
+    for ( const std::string & rhs : words )
+      for ( unsigned max = 0; max <= 4; ++max )
+      {
+	unsigned expect = std::min( full( lhs, rhs ), max + 1 );
+	BOOST_CHECK_MESSAGE( FuzzyNameIndex::distance( lhs, rhs, max ) == expect, lhs << " " << rhs << " " << max );
+      }
+}
+
+BOOST_AUTO_TEST_CASE(lookup)
+{
+  FuzzyNameIndex index;
+  BOOST_CHECK( index.lookup( "zypper", 2 ).empty() );
+
+  for ( const char * name : { "zypper-log", "libzypp", "zypp", "zypper", "Zypper", "zyper", "yast2" } )
+    index.add( name );
+  BOOST_CHECK_EQUAL( index.size(), 7 );
+
+  // the name itself is not reported, but a case variant is (distance 0)
+  BOOST_CHECK( index.lookup( "zypper", 2 ) == Names({ "Zypper", "zyper", "zypp" }) );
+  BOOST_CHECK( index.lookup( "zypper", 2, 2 ) == Names({ "Zypper", "zyper" }) );
+  BOOST_CHECK( index.lookup( "zypper", 1 ) == Names({ "Zypper", "zyper" }) );
+  BOOST_CHECK( index.lookup( "zypper", 0 ) == Names({ "Zypper" }) );
+  BOOST_CHECK( index.lookup( "ZYPPER", 0 ) == Names({ "Zypper", "zypper" }) );
+  BOOST_CHECK( index.lookup( "zypper", 2, 0 ).empty() );
+  BOOST_CHECK( index.lookup( "kernel", 2 ).empty() );
+}
+
+BOOST_AUTO_TEST_CASE(lookup_ties_and_limit)
+{
+  FuzzyNameIndex index;
+  for ( const char * name : { "vin", "vim2", "vi", "gvim" } )
+    index.add( name );
+  // same distance: alphabetically
+  BOOST_CHECK( index.lookup( "vim", 1 ) == Names({ "gvim", "vi", "vim2" }) );
+
+  // Many names at distance 2 are visited first (shorter), the limit gets
+  // tightened; the closer ones found later must still win.
+  FuzzyNameIndex many;
+  for ( char x = 'e'; x <= 'z'; ++x )
+    many.add( std::string( "ab" ) + x + x );
+  for ( const char * name : { "abcdg", "abcde", "abcdf" } )
+    many.add( name );
+  BOOST_CHECK( many.lookup( "abcd", 2 ) == Names({ "abcde", "abcdf", "abcdg" }) );
+}
+
+BOOST_AUTO_TEST_CASE(max_distance)
+{
+  BOOST_CHECK_EQUAL( FuzzyNameIndex::defaultMaxDistance( 3 ),	1 );
+  BOOST_CHECK_EQUAL( FuzzyNameIndex::defaultMaxDistance( 4 ),	1 );
+  BOOST_CHECK_EQUAL( FuzzyNameIndex::defaultMaxDistance( 5 ),	2 );
+  BOOST_CHECK_EQUAL( FuzzyNameIndex::defaultMaxDistance( 10 ),	2 );
+  BOOST_CHECK_EQUAL( FuzzyNameIndex::defaultMaxDistance( 11 ),	3 );
+}
+
+BOOST_AUTO_TEST_CASE(kinds)
+{
+  TestSetup test( Arch_x86_64 );
+  test.loadRepo( TESTS_SRC_DIR "/data/openSUSE-11.1", "main" );	// packages and patterns
+
+  // similarNamesHint looks up names of the requested kind only
+  BOOST_CHECK_EQUAL( similarNamesHint( "devel_basic", ResKind::pattern ).substr( 0, 11 ), "devel_basis" );	// closest first
+  BOOST_CHECK( similarNamesHint( "devel_basic", ResKind::package ).find( "devel_basis" ) == std::string::npos );
+  BOOST_CHECK( similarNamesHint( "DEVEL_BASIS", ResKind::pattern ).find( "devel_basis" ) != std::string::npos );
+}
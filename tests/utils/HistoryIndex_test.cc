@@ -0,0 +1,106 @@
+#include "TestSetup.h"
+#include "utils/HistoryIndex.h"
+
+#include <fstream>
+#include <vector>
+
+namespace
+{
+  void append( const Pathname & file_r, const std::string & text_r )
+  { std::ofstream( file_r.c_str(), std::ios_base::app ) << text_r; }
+
+  /** Remember lines 'date name state' and collect all lines seen. */
+  HistoryIndex::LineParser parser( HistoryIndex & index_r, std::vector<std::string> & seen_r )
+  {
+    return [&]( const std::string & line_r ) {
+      seen_r.push_back( line_r );
+      std::istringstream str( line_r );
+      HistoryIndex::Entry entry;
+      str >> entry._date >> entry._name >> entry._state;
+      entry._edition = "1";
+      entry._arch = "noarch";
+      index_r.remember( entry );
+    };
+  }
+}
+
+BOOST_AUTO_TEST_CASE(incremental)
+{
+  filesystem::TmpDir tmp;
+  Pathname log( tmp.path() / "history" );
+  std::string idx( ( tmp.path() / "cache/history.index" ).asString() );	// parent created on demand
+
+  append( log, "10 p1 needed\n20 p2 needed\n" );
+  {
+    HistoryIndex index( idx );
+    std::vector<std::string> seen;
+    BOOST_REQUIRE( index.update( log.asString(), parser( index, seen ) ) );
+    BOOST_CHECK_EQUAL( seen.size(), 2 );
+    BOOST_CHECK_EQUAL( index.entries().size(), 2 );
+    BOOST_REQUIRE( index.save() );
+  }
+
+  append( log, "30 p1 applied\n40 p3 nee" );	// last line incomplete
+  {
+    HistoryIndex index( idx );
+    BOOST_CHECK_EQUAL( index.entries().size(), 2 );
+    std::vector<std::string> seen;
+    BOOST_REQUIRE( index.update( log.asString(), parser( index, seen ) ) );
+    BOOST_REQUIRE_EQUAL( seen.size(), 1 );	// only the appended complete line
+    BOOST_CHECK_EQUAL( seen[0], "30 p1 applied" );
+    BOOST_CHECK_EQUAL( index.entries().at( "p1 1 noarch" )._state, "applied" );
+    BOOST_CHECK_EQUAL( index.entries().at( "p1 1 noarch" )._date, 30 );
+    BOOST_REQUIRE( index.save() );
+  }
+
+  append( log, "ded\n" );
+  {
+    HistoryIndex index( idx );
+    std::vector<std::string> seen;
+    BOOST_REQUIRE( index.update( log.asString(), parser( index, seen ) ) );
+    BOOST_REQUIRE_EQUAL( seen.size(), 1 );
+    BOOST_CHECK_EQUAL( seen[0], "40 p3 needed" );
+    BOOST_CHECK_EQUAL( index.entries().size(), 3 );
+  }
+}
+
+BOOST_AUTO_TEST_CASE(rotated)
+{
+  filesystem::TmpDir tmp;
+  Pathname log( tmp.path() / "history" );
+  std::string idx( ( tmp.path() / "history.index" ).asString() );
+
+  append( log, "10 p1 needed\n20 p2 needed\n" );
+  {
+    HistoryIndex index( idx );
+    std::vector<std::string> seen;
+    index.update( log.asString(), parser( index, seen ) );
+    BOOST_REQUIRE( index.save() );
+  }
+
+  // truncated in place and rewritten: same inode, larger than before
+  std::ofstream( log.c_str(), std::ios_base::trunc ) << "50 p4 needed\n60 p5 needed\n70 p6 needed\n";
+  {
+    HistoryIndex index( idx );
+    std::vector<std::string> seen;
+    BOOST_REQUIRE( index.update( log.asString(), parser( index, seen ) ) );
+    BOOST_CHECK_EQUAL( seen.size(), 3 );
+    BOOST_CHECK_EQUAL( index.entries().size(), 3 );	// the old entries are dropped
+    BOOST_CHECK( index.entries().count( "p1 1 noarch" ) == 0 );
+    BOOST_REQUIRE( index.save() );
+  }
+
+  // shrunk
+  std::ofstream( log.c_str(), std::ios_base::trunc ) << "80 p7 needed\n";
+  {
+    HistoryIndex index( idx );
+    std::vector<std::string> seen;
+    BOOST_REQUIRE( index.update( log.asString(), parser( index, seen ) ) );
+    BOOST_CHECK_EQUAL( seen.size(), 1 );
+    BOOST_CHECK_EQUAL( index.entries().size(), 1 );
+  }
+
+  HistoryIndex index( idx );
+  std::vector<std::string> seen;
+  BOOST_CHECK( ! index.update( ( tmp.path() / "nosuchfile" ).asString(), parser( index, seen ) ) );
+}
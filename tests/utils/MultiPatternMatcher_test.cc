@@ -0,0 +1,44 @@
+#include "TestSetup.h"
+#include "utils/MultiPatternMatcher.h"
+
+BOOST_AUTO_TEST_CASE(substrings)
+{
+  MultiPatternMatcher m;
+  BOOST_CHECK_EQUAL( m.matches( "zypper" ),	false );	// no pattern, no match
+
+  m.add( "zypp" );
+  m.add( "yast2" );
+  m.add( "he" );
+  m.add( "she" );
+  m.add( "hers" );
+
+  BOOST_CHECK_EQUAL( m.matches( "libzypp-devel" ),	true );
+  BOOST_CHECK_EQUAL( m.matches( "YaST2-Packager" ),	true );	// case-insensitive
+  BOOST_CHECK_EQUAL( m.matches( "ushers" ),		true );	// overlapping patterns
+  BOOST_CHECK_EQUAL( m.matches( "shx" ),		false );
+  BOOST_CHECK_EQUAL( m.matches( "yast" ),		false );
+  BOOST_CHECK_EQUAL( m.matches( "" ),			false );
+
+  m.add( "" );							// empty pattern matches all
+  BOOST_CHECK_EQUAL( m.matches( "" ),			true );
+}
+
+BOOST_AUTO_TEST_CASE(substrings_case_sensitive)
+{
+  MultiPatternMatcher m( MultiPatternMatcher::Mode::Substring, true );
+  m.add( "YaST" );
+  BOOST_CHECK_EQUAL( m.matches( "yast2" ),	false );
+  BOOST_CHECK_EQUAL( m.matches( "YaST2" ),	true );
+}
+
+BOOST_AUTO_TEST_CASE(exact)
+{
+  MultiPatternMatcher m( MultiPatternMatcher::Mode::Exact );
+  m.add( "zypper" );
+  m.add( "libzypp" );
+
+  BOOST_CHECK_EQUAL( m.size(),				2 );
+  BOOST_CHECK_EQUAL( m.matches( "Zypper" ),		true );
+  BOOST_CHECK_EQUAL( m.matches( "zypper-log" ),		false );
+  BOOST_CHECK_EQUAL( m.matches( "zypp" ),		false );
+}
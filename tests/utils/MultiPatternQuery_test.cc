@@ -0,0 +1,78 @@
+#include "TestSetup.h"
+#include "utils/MultiPatternQuery.h"
+
+#include <zypp/PoolQuery.h>
+
+#include <set>
+#include <vector>
+
+namespace
+{
+  struct TestInit {
+    TestInit()
+      : testSetup( std::make_unique<TestSetup>( Arch_x86_64 ) )
+    {
+      testSetup->loadRepo( TESTS_SRC_DIR "/data/openSUSE-11.1", "main" );		// patterns
+      testSetup->loadRepo( TESTS_SRC_DIR "/data/openSUSE-11.1_updates", "upd" );	// patches
+    }
+    std::unique_ptr<TestSetup> testSetup;
+  };
+
+  using Result = std::set<sat::Solvable>;
+
+  /** What the search command's PoolQuery finds. */
+  Result viaPoolQuery( const ResKind & kind_r, const std::vector<std::string> & args_r, bool exact_r )
+  {
+    PoolQuery q;
+    q.addKind( kind_r );
+    if ( exact_r )
+      q.setMatchExact();
+    for ( const std::string & arg : args_r )
+      q.addDependency( sat::SolvAttr::name, arg, Rel::ANY, Edition(), Arch(), Match::OTHER );
+    return Result( q.begin(), q.end() );
+  }
+
+  /** What the single pass MultiPatternQuery finds. */
+  Result viaMultiPatternQuery( const ResKind & kind_r, const std::vector<std::string> & args_r, bool exact_r )
+  {
+    MultiPatternQuery mq( exact_r ? MultiPatternMatcher::Mode::Exact : MultiPatternMatcher::Mode::Substring, false );
+    for ( const std::string & arg : args_r )
+      mq._matcher.add( arg );
+
+    PoolQuery base;
+    base.addKind( kind_r );
+    Result ret;
+    for ( const sat::Solvable & solv : base )
+      if ( mq( solv ) )
+	ret.insert( solv );
+    return ret;
+  }
+}
+BOOST_GLOBAL_FIXTURE( TestInit );
+
+BOOST_AUTO_TEST_CASE(patterns)
+{
+  const std::vector<std::string> exact { "base", "console", "devel_basis", "devel_java", "apparmor", "x11", "gnome", "nosuchpattern" };
+  Result expected { viaPoolQuery( ResKind::pattern, exact, true ) };
+  BOOST_CHECK( ! expected.empty() );
+  BOOST_CHECK( viaMultiPatternQuery( ResKind::pattern, exact, true ) == expected );
+
+  // substrings must not match the "pattern:" prefix of the ident
+  const std::vector<std::string> substr { "pat", "tern", "devel_k", "32bit", "APPARMOR", "consol", "ase", "nosuchpattern" };
+  expected = viaPoolQuery( ResKind::pattern, substr, false );
+  BOOST_CHECK( ! expected.empty() );
+  BOOST_CHECK( viaMultiPatternQuery( ResKind::pattern, substr, false ) == expected );
+}
+
+BOOST_AUTO_TEST_CASE(patches)
+{
+  const std::vector<std::string> exact { "aaa_base", "acl", "Mesa", "PolicyKit", "NetworkManager", "OpenEXR", "patch", "nosuchpatch" };
+  Result expected { viaPoolQuery( ResKind::patch, exact, true ) };
+  BOOST_CHECK( ! expected.empty() );
+  BOOST_CHECK( viaMultiPatternQuery( ResKind::patch, exact, true ) == expected );
+
+  const std::vector<std::string> substr { "atch", "ACL", "mozilla", "NetworkManager-", "base", "Magick", "Kit", "nosuchpatch" };
+  expected = viaPoolQuery( ResKind::patch, substr, false );
+  BOOST_CHECK( ! expected.empty() );
+  BOOST_CHECK( viaMultiPatternQuery( ResKind::patch, substr, false ) == expected );
+}
@@ -0,0 +1,226 @@
+#include "TestSetup.h"
+#include "utils/PatchIssueIndex.h"
+
+#include <zypp/PoolQuery.h>
+
+#include <map>
+#include <set>
+
+namespace
+{
+  struct TestInit {
+    TestInit()
+      : testSetup( std::make_unique<TestSetup>( Arch_x86_64 ) )
+    {
+      testSetup->loadRepo( TESTS_SRC_DIR "/data/openSUSE-11.1_updates", "upd" );	// patches with bugzilla and cve references
+    }
+    std::unique_ptr<TestSetup> testSetup;
+  };
+
+  using IssueMatches = std::map<PoolItem,std::map<std::string,std::set<std::string>>>;
+  using Patches = std::set<PoolItem>;
+  using Named = std::multiset<std::string>;
+
+  /** 'list-patches' issue matches the way they used to be found: a PoolQuery per issue. */
+  IssueMatches matchingViaPoolQuery( const std::set<Issue> & issues_r )
+  {
+    IssueMatches ret;
+    for ( const Issue & issue : issues_r )
+    {
+      PoolQuery q;
+      q.setMatchSubstring();
+      q.setCaseSensitive( false );
+      q.addKind( ResKind::patch );
+      if ( issue.specificType() && issue.anyId() )
+      { q.addAttribute( sat::SolvAttr::updateReferenceType, issue.type() ); }
+      else
+      {
+	q.addAttribute( sat::SolvAttr::updateReferenceId, issue.id() );
+	if ( issue.anyType() && issue.specificId() )
+	  q.addAttribute( sat::SolvAttr::updateReferenceType, issue.id() );
+      }
+
+      for_( it, q.begin(), q.end() )
+      {
+	for_( d, it.matchesBegin(), it.matchesEnd() )
+	{
+	  std::string itype { d->subFind( sat::SolvAttr::updateReferenceType ).asString() };
+	  if ( issue.specificType() && itype != issue.type() )
+	    continue;
+	  ret[PoolItem(*it)][itype].insert( d->subFind( sat::SolvAttr::updateReferenceId ).asString() );
+	}
+      }
+    }
+    return ret;
+  }
+
+  IssueMatches matchingViaIndex( const std::set<Issue> & issues_r )
+  {
+    IssueMatches ret;
+    PatchIssueIndex index;
+    PoolItem last;
+    std::set<PoolItem> seen;
+    for ( const PatchIssueIndex::Ref * ref : index.matching( issues_r ) )
+    {
+      if ( ref->_pi != last )
+      {
+	BOOST_CHECK_MESSAGE( seen.insert( ref->_pi ).second, "matches not grouped by patch" );
+	last = ref->_pi;
+      }
+      ret[ref->_pi][ref->_type].insert( ref->_id );
+    }
+    return ret;
+  }
+
+  /** 'list-patches' description matches the way they used to be found. */
+  Patches describingViaPoolQuery( const std::set<Issue> & issues_r )
+  {
+    Patches ret;
+    for ( const Issue & issue : issues_r )
+    {
+      if ( ! ( issue.anyType() && issue.specificId() ) )
+	continue;
+      PoolQuery q;
+      q.setMatchSubstring();
+      q.setCaseSensitive( false );
+      q.addKind( ResKind::patch );
+      q.addAttribute( sat::SolvAttr::summary, issue.id() );
+      q.addAttribute( sat::SolvAttr::description, issue.id() );
+      for_( it, q.begin(), q.end() )
+	ret.insert( PoolItem(*it) );
+    }
+    return ret;
+  }
+
+  Patches describingViaIndex( const std::set<Issue> & issues_r )
+  {
+    std::vector<PoolItem> found { PatchIssueIndex::describing( issues_r ) };
+    Patches ret( found.begin(), found.end() );
+    BOOST_CHECK_EQUAL( ret.size(), found.size() );	// each patch once
+    return ret;
+  }
+
+  /** 'patch' issue lookup the way it used to be done. */
+  Named namingViaPoolQuery( const Issue & issue_r )
+  {
+    Named ret;
+    PoolQuery q;
+    q.setMatchExact();
+    q.setCaseSensitive( false );
+    q.addKind( ResKind::patch );
+    if ( issue_r.specificType() && issue_r.anyId() )
+    { q.addAttribute( sat::SolvAttr::updateReferenceType, issue_r.type() ); }
+    else
+    { q.addAttribute( sat::SolvAttr::updateReferenceId, issue_r.id() ); }
+
+    for_( it, q.begin(), q.end() )
+    {
+      for_( d, it.matchesBegin(), it.matchesEnd() )
+      {
+	std::string itype { d->subFind( sat::SolvAttr::updateReferenceType ).asString() };
+	if ( issue_r.specificType() && itype != issue_r.type() )
+	  continue;
+	ret.insert( str::Str() << it->ident() << " " << itype << " " << d->subFind( sat::SolvAttr::updateReferenceId ).asString() );
+      }
+    }
+    return ret;
+  }
+
+  Named namingViaIndex( const PatchIssueIndex & index_r, const Issue & issue_r )
+  {
+    Named ret;
+    for ( const PatchIssueIndex::Ref * ref : index_r.naming( issue_r ) )
+      ret.insert( str::Str() << ref->_pi.ident() << " " << ref->_type << " " << ref->_id );
+    return ret;
+  }
+
+  size_t countRefs( const IssueMatches & matches_r )
+  {
+    size_t ret = 0;
+    for ( const auto & byPatch : matches_r )
+      for ( const auto & byType : byPatch.second )
+	ret += byType.second.size();
+    return ret;
+  }
+}
+BOOST_GLOBAL_FIXTURE( TestInit );
+
+BOOST_AUTO_TEST_CASE(index)
+{
+  PatchIssueIndex index;
+  BOOST_CHECK( index.refs().size() > 1000 );
+  BOOST_CHECK( ! index.byId( "458579" ).empty() );
+  BOOST_CHECK_EQUAL( index.byId( "cve-2009-3794" ).size(), index.byId( "CVE-2009-3794" ).size() );
+  BOOST_CHECK( ! index.byId( "CVE-2009-3794" ).empty() );
+  BOOST_CHECK( ! index.byType( "cve" ).empty() );
+  BOOST_CHECK( index.byType( "CVE" ).empty() );
+}
+
+BOOST_AUTO_TEST_CASE(matching)
+{
+  const std::vector<std::set<Issue>> requests {
+    // many issues of specific types, ids as substrings
+    { Issue( "bugzilla", "458579" ), Issue( "bugzilla", "45937" ), Issue( "bugzilla", "4593" ), Issue( "cve", "cve-2009-37" ), Issue( "cve", "CVE-2009-3050" ) },
+    // ids of the wrong type
+    { Issue( "cve", "458579" ), Issue( "bugzilla", "CVE-2009-3050" ) },
+    // types only: exact type
+    { Issue( "cve", "" ) },
+    { Issue( "CVE", "" ), Issue( "cv", "" ), Issue( "bug", "" ) },
+    // without type: matches the id or the type (--issue=bugzilla), or the description
+    { Issue( "", "12345" ), Issue( "", "cve-2009-3796" ), Issue( "", "overflow" ) },
+    { Issue( "", "bugzilla" ) },
+    { Issue( "", "ecurit" ) },
+    // all mixed
+    { Issue( "bugzilla", "458579" ), Issue( "cve", "" ), Issue( "", "12345" ), Issue( "", "overflow" ), Issue( "", "bugzilla" ), Issue( "CVE", "" ), Issue( "", "nosuchissue" ) },
+  };
+
+  for ( const std::set<Issue> & issues : requests )
+  {
+    BOOST_TEST_MESSAGE( "issues: " << issues.size() << " first " << *issues.begin() );
+    IssueMatches expected { matchingViaPoolQuery( issues ) };
+    BOOST_CHECK( matchingViaIndex( issues ) == expected );
+    BOOST_CHECK( describingViaIndex( issues ) == describingViaPoolQuery( issues ) );
+  }
+
+  // not just equally empty
+  BOOST_CHECK_EQUAL( countRefs( matchingViaIndex( requests[0] ) ), countRefs( matchingViaPoolQuery( requests[0] ) ) );
+  BOOST_CHECK( countRefs( matchingViaIndex( requests[0] ) ) > 5 );
+  BOOST_CHECK( matchingViaIndex( requests[1] ).empty() );
+  BOOST_CHECK( ! matchingViaIndex( requests[2] ).empty() );
+  BOOST_CHECK( matchingViaIndex( requests[3] ).empty() );	// type case and substrings don't match
+  BOOST_CHECK( ! matchingViaIndex( requests[4] ).empty() );
+  BOOST_CHECK( ! describingViaIndex( requests[4] ).empty() );	// 'overflow' in descriptions
+  BOOST_CHECK( ! matchingViaIndex( requests[5] ).empty() );
+  BOOST_CHECK( ! describingViaIndex( requests[6] ).empty() );
+}
+
+BOOST_AUTO_TEST_CASE(naming)
+{
+  PatchIssueIndex index;
+  const std::vector<Issue> issues {
+    Issue( "bugzilla", "458579" ),
+    Issue( "bugzilla", "455804" ),		// referenced more than once
+    Issue( "cve", "cve-2009-3794" ),	// case insensitive id
+    Issue( "bugzilla", "CVE-2009-3794" ),	// wrong type
+    Issue( "bugzilla", "4585" ),		// no substrings
+    Issue( "", "458579" ),
+    Issue( "cve", "" ),
+    Issue( "CVE", "" ),
+    Issue( "bugzilla", "nosuchissue" ),
+  };
+
+  for ( const Issue & issue : issues )
+  {
+    BOOST_TEST_MESSAGE( issue );
+    BOOST_CHECK( namingViaIndex( index, issue ) == namingViaPoolQuery( issue ) );
+  }
+
+  BOOST_CHECK( ! namingViaIndex( index, issues[0] ).empty() );
+  BOOST_CHECK( namingViaIndex( index, issues[1] ).size() > 1 );
+  BOOST_CHECK( ! namingViaIndex( index, issues[2] ).empty() );
+  BOOST_CHECK( namingViaIndex( index, issues[3] ).empty() );
+  BOOST_CHECK( namingViaIndex( index, issues[4] ).empty() );
+  BOOST_CHECK( namingViaIndex( index, issues[5] ) == namingViaIndex( index, issues[0] ) );
+  BOOST_CHECK_EQUAL( namingViaIndex( index, issues[6] ).size(), index.byType( "cve" ).size() );
+  BOOST_CHECK( namingViaIndex( index, issues[7] ).empty() );
+}
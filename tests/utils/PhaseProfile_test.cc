@@ -0,0 +1,81 @@
+#include "TestSetup.h"
+#include "utils/PhaseProfile.h"
+
+namespace
+{
+  PhaseProfile::Sample sample( int ms_r, long cpu_r = 0, long rss_r = 0, long long read_r = 0 )
+  {
+    PhaseProfile::Sample ret;
+    ret._wall = PhaseProfile::Clock::time_point( std::chrono::milliseconds( ms_r ) );
+    ret._cpu = std::chrono::milliseconds( cpu_r );
+    ret._maxrss = rss_r;
+    ret._read = read_r;
+    ret._written = -1;	// unknown
+    return ret;
+  }
+
+  long ms( PhaseProfile::Clock::duration d_r )
+  { return std::chrono::duration_cast<std::chrono::milliseconds>( d_r ).count(); }
+}
+
+BOOST_AUTO_TEST_CASE(disabled)
+{
+  PhaseProfile profile;
+  BOOST_CHECK( ! profile.enabled() );
+  {
+    PhaseProfile::Scope scope( "resolve", profile );
+  }
+  BOOST_CHECK( profile.empty() );
+}
+
+BOOST_AUTO_TEST_CASE(phases)
+{
+  PhaseProfile profile;
+  profile.start( "commit", sample( 0, 0, 100, 0 ) );
+  profile.start( "download", sample( 10 ) );
+  profile.start( "download", sample( 20 ) );	// concurrent
+  profile.stop( "download", sample( 30 ) );
+  profile.stop( "download", sample( 50, 0, 0, 4096 ) );
+  profile.start( "download", sample( 60 ) );	// again
+  profile.stop( "download", sample( 70 ) );
+  profile.stop( "unknown", sample( 70 ) );	// ignored
+  profile.start( "rpm", sample( 80, 5 ) );
+  profile.stop( "rpm", sample( 100, 15 ) );
+  profile.stop( "commit", sample( 100, 20, 150, 8192 ) );
+
+  std::vector<PhaseProfile::Phase> phases( profile.phases() );
+  BOOST_REQUIRE_EQUAL( phases.size(), 3 );
+
+  BOOST_CHECK_EQUAL( phases[0]._name, "commit" );
+  BOOST_CHECK_EQUAL( phases[0]._depth, 0 );
+  BOOST_CHECK_EQUAL( phases[0]._count, 1 );
+  BOOST_CHECK_EQUAL( ms( phases[0]._wall ), 100 );
+  BOOST_CHECK_EQUAL( phases[0]._cpu.count(), 20000 );
+  BOOST_CHECK_EQUAL( phases[0]._rss, 50 );
+  BOOST_CHECK_EQUAL( phases[0]._read, 8192 );
+  BOOST_CHECK_EQUAL( phases[0]._written, -1 );
+
+  BOOST_CHECK_EQUAL( phases[1]._name, "download" );
+  BOOST_CHECK_EQUAL( phases[1]._depth, 1 );
+  BOOST_CHECK_EQUAL( phases[1]._count, 2 );
+  BOOST_CHECK_EQUAL( ms( phases[1]._wall ), 50 );	// 10..50 and 60..70
+  BOOST_CHECK_EQUAL( phases[1]._read, 4096 );
+
+  BOOST_CHECK_EQUAL( phases[2]._name, "rpm" );
+  BOOST_CHECK_EQUAL( phases[2]._depth, 1 );
+  BOOST_CHECK_EQUAL( phases[2]._cpu.count(), 10000 );
+}
+
+BOOST_AUTO_TEST_CASE(stop_all)
+{
+  PhaseProfile profile;
+  profile.start( "init_target", sample( 0 ) );
+  profile.start( "load_resolvables", sample( 10 ) );
+  profile.stopAll( sample( 40 ) );
+
+  std::vector<PhaseProfile::Phase> phases( profile.phases() );
+  BOOST_REQUIRE_EQUAL( phases.size(), 2 );
+  BOOST_CHECK_EQUAL( ms( phases[0]._wall ), 40 );
+  BOOST_CHECK_EQUAL( ms( phases[1]._wall ), 30 );
+  BOOST_CHECK_EQUAL( phases[1]._active, 0 );
+}
@@ -0,0 +1,46 @@
+#include "TestSetup.h"
+#include "utils/ResultCache.h"
+
+#include <sstream>
+
+BOOST_AUTO_TEST_CASE(capture)
+{
+  std::ostringstream str;
+  {
+    ResultCache::Capture capture( str );
+    str << "Loading" << std::endl << 'x';
+    BOOST_CHECK_EQUAL( capture.str(), "Loading\nx" );
+  }
+  str << "!";	// no longer captured
+  BOOST_CHECK_EQUAL( str.str(), "Loading\nx!" );
+}
+
+BOOST_AUTO_TEST_CASE(store_lookup)
+{
+  filesystem::TmpDir tmp;
+  ResultCache cache( ( tmp.path() / "a/b" ).asString() );	// created on demand
+
+  ResultCache::Entry entry;
+  BOOST_CHECK( ! cache.lookup( "lu", "fp1", entry ) );
+
+  entry._fingerprint = "fp1";
+  entry._exitCode = 100;
+  entry._output = "3 updates\n\n";	// trailing newlines are kept
+  BOOST_REQUIRE( cache.store( "lu", entry ) );
+
+  ResultCache::Entry found;
+  BOOST_REQUIRE( cache.lookup( "lu", "fp1", found ) );
+  BOOST_CHECK_EQUAL( found._exitCode, 100 );
+  BOOST_CHECK_EQUAL( found._output, "3 updates\n\n" );
+
+  BOOST_CHECK( ! cache.lookup( "lu", "fp2", found ) );	// system changed
+  BOOST_CHECK( ! cache.lookup( "lp", "fp1", found ) );	// other query
+
+  entry._fingerprint = "fp2";
+  entry._exitCode = 0;
+  entry._output.clear();
+  BOOST_REQUIRE( cache.store( "lu", entry ) );	// replaces the old one
+  BOOST_CHECK( ! cache.lookup( "lu", "fp1", found ) );
+  BOOST_REQUIRE( cache.lookup( "lu", "fp2", found ) );
+  BOOST_CHECK_EQUAL( found._output, "" );
+}
@@ -0,0 +1,71 @@
+#include "TestSetup.h"
+#include "utils/TraceFile.h"
+
+namespace
+{
+  /** Lines of the trace written, with the variable pid/ts removed. */
+  std::vector<std::string> traceLines( const std::string & trace_r )
+  {
+    std::vector<std::string> ret;
+    std::istringstream str( trace_r );
+    std::string line;
+    while ( std::getline( str, line ) )
+    {
+      for ( const char * key : { "\"pid\":", "\"ts\":" } )
+      {
+	std::string::size_type pos = line.find( key );
+	if ( pos != std::string::npos )
+	  line.erase( pos, line.find_first_of( ",}", pos ) - pos + 1 );
+      }
+      ret.push_back( line );
+    }
+    return ret;
+  }
+}
+
+BOOST_AUTO_TEST_CASE(closed)
+{
+  TraceFile trace;
+  BOOST_CHECK( ! trace.isOpen() );
+  trace.begin( "a", "a", "download" );	// ignored
+  trace.end( "a" );
+  trace.close();
+}
+
+BOOST_AUTO_TEST_CASE(events)
+{
+  std::ostringstream str;
+  TraceFile trace;
+  trace.open( str );
+  BOOST_CHECK( trace.isOpen() );
+
+  TraceFile::Clock::time_point t0( TraceFile::Clock::now() );
+  using std::chrono::milliseconds;
+  trace.begin( "c", "commit", TraceFile::mainCategory, {}, t0 );
+  trace.begin( "u1", "foo.rpm", "download", {}, t0 );
+  trace.begin( "u2", "bar.rpm", "download", { { "url", "http://x/\"bar\".rpm" } }, t0 + milliseconds( 1 ) );
+  trace.end( "u1", { { "error", "0" } }, t0 + milliseconds( 2 ) );
+  trace.begin( "u3", "baz.rpm", "download", {}, t0 + milliseconds( 3 ) );	// 1st track is free again
+  trace.end( "u3", {}, t0 + milliseconds( 4 ) );
+  trace.end( "u3", {}, t0 + milliseconds( 5 ) );	// ignored
+  trace.begin( "r", "foo", "rpm", {}, t0 + milliseconds( 5 ) );
+  trace.close();	// ends u2, r and c
+  BOOST_CHECK( ! trace.isOpen() );
+
+  std::vector<std::string> lines( traceLines( str.str() ) );
+  BOOST_REQUIRE_EQUAL( lines.size(), 11 );
+  BOOST_CHECK_EQUAL( lines[0], "[" );
+  BOOST_CHECK_EQUAL( lines[1], "{\"name\":\"thread_name\",\"ph\":\"M\",\"tid\":1,\"args\":{\"name\":\"zypper\"}}," );
+  BOOST_CHECK_EQUAL( lines[2], "{\"name\":\"thread_name\",\"ph\":\"M\",\"tid\":100,\"args\":{\"name\":\"download 1\"}}," );
+  BOOST_CHECK_EQUAL( lines[3], "{\"name\":\"thread_name\",\"ph\":\"M\",\"tid\":101,\"args\":{\"name\":\"download 2\"}}," );
+  BOOST_CHECK_EQUAL( lines[4], "{\"name\":\"foo.rpm\",\"cat\":\"download\",\"ph\":\"X\",\"dur\":2000,\"tid\":100,\"args\":{\"error\":\"0\"}}," );
+  BOOST_CHECK_EQUAL( lines[5], "{\"name\":\"baz.rpm\",\"cat\":\"download\",\"ph\":\"X\",\"dur\":1000,\"tid\":100}," );
+  BOOST_CHECK_EQUAL( lines[6], "{\"name\":\"thread_name\",\"ph\":\"M\",\"tid\":200,\"args\":{\"name\":\"rpm 1\"}}," );
+  // close: the running ones by key
+  BOOST_CHECK( lines[7].find( "\"name\":\"commit\",\"cat\":\"zypper\"" ) != std::string::npos );
+  BOOST_CHECK( lines[7].find( "\"tid\":1}" ) != std::string::npos );
+  BOOST_CHECK_EQUAL( lines[8].find( "\"name\":\"foo\",\"cat\":\"rpm\"" ), 1 );
+  BOOST_CHECK( lines[9].find( "{\"name\":\"bar.rpm\"" ) == 0 );
+  BOOST_CHECK( lines[9].find( "\"tid\":101,\"args\":{\"url\":\"http://x/\\\"bar\\\".rpm\"}}" ) != std::string::npos );
+  BOOST_CHECK_EQUAL( lines[10], "]" );
+}
@@ -0,0 +1,59 @@
+#include "TestSetup.h"
+#include "utils/XmlToJsonLines.h"
+
+namespace
+{
+  std::string toJsonLines( const std::string & xml_r )
+  {
+    std::ostringstream out;
+    {
+      XmlToJsonLines buf( out.rdbuf() );
+      std::ostream str( &buf );
+      str << xml_r;
+    }
+    return out.str();
+  }
+}
+
+BOOST_AUTO_TEST_CASE(escaping)
+{
+  BOOST_CHECK_EQUAL( XmlToJsonLines::xmlUnescape( "a &lt;b&gt; &amp;&quot;&apos; &#228;&#x41; &foo;" ),	"a <b> &\"' \xC3\xA4" "A &foo;" );
+  BOOST_CHECK_EQUAL( XmlToJsonLines::jsonString( "a\"b\\c\n\t\x01" ),	"\"a\\\"b\\\\c\\n\\t\\u0001\"" );
+}
+
+BOOST_AUTO_TEST_CASE(elements)
+{
+  BOOST_CHECK_EQUAL( toJsonLines( "<?xml version='1.0'?>\n<stream>\n"
+				  "<message type=\"info\">Done &amp; dusted</message>\n"
+				  "<progress id=\"1\" name=\"a &gt; b\" value='5'/>\n"
+				  "some text\n"
+				  "</stream>\n" ),
+		     "{\"element\":\"message\",\"attributes\":{\"type\":\"info\"},\"text\":\"Done & dusted\"}\n"
+		     "{\"element\":\"progress\",\"attributes\":{\"id\":\"1\",\"name\":\"a > b\",\"value\":\"5\"}}\n"
+		     "{\"element\":\"text\",\"text\":\"some text\"}\n" );
+
+  // nested elements, comments and CDATA
+  BOOST_CHECK_EQUAL( toJsonLines( "<prompt id=\"1\">\n<!-- a > b -->\n<text>Continue?</text>\n"
+				  "<option default=\"1\" value=\"y\"/>\n<![CDATA[<raw>]]>\n</prompt>" ),
+		     "{\"element\":\"prompt\",\"attributes\":{\"id\":\"1\"},\"text\":\"<raw>\",\"children\":["
+		     "{\"element\":\"text\",\"text\":\"Continue?\"},"
+		     "{\"element\":\"option\",\"attributes\":{\"default\":\"1\",\"value\":\"y\"}}]}\n" );
+}
+
+BOOST_AUTO_TEST_CASE(streamed_lists)
+{
+  BOOST_CHECK_EQUAL( toJsonLines( "<stream><search-result version=\"0.0\">\n<solvable-list>\n"
+				  "<solvable name=\"a\"/>\n<solvable name=\"b\"/>\n"
+				  "</solvable-list>\n</search-result></stream>" ),
+		     "{\"element\":\"search-result\",\"event\":\"begin\",\"attributes\":{\"version\":\"0.0\"}}\n"
+		     "{\"element\":\"solvable-list\",\"event\":\"begin\"}\n"
+		     "{\"element\":\"solvable\",\"attributes\":{\"name\":\"a\"}}\n"
+		     "{\"element\":\"solvable\",\"attributes\":{\"name\":\"b\"}}\n"
+		     "{\"element\":\"solvable-list\",\"event\":\"end\"}\n"
+		     "{\"element\":\"search-result\",\"event\":\"end\"}\n" );
+
+  // lists are streamed at top level only
+  BOOST_CHECK_EQUAL( toJsonLines( "<selectable><solvable-list><solvable name=\"a\"/></solvable-list></selectable>" ),
+		     "{\"element\":\"selectable\",\"children\":[{\"element\":\"solvable-list\",\"children\":["
+		     "{\"element\":\"solvable\",\"attributes\":{\"name\":\"a\"}}]}]}\n" );
+}
@@ -0,0 +1,90 @@
+// Microbenchmark for Out::bufferStdout: write(2) calls for a 'zypper -x se' like output.
+// Not run by ctest: build target 'stdout_bench' and run it manually:
+//   stdout_bench [ROWS] | cat >/dev/null		# each line flushed (std::endl)
+//   stdout_bench --buffered [ROWS] | cat >/dev/null	# Out::bufferStdout
+// Stdout must not be a terminal (Out::bufferStdout is a noop then).
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "output/Out.h"
+
+namespace
+{
+  ///////////////////////////////////////////////////////////////////
+  /// Stdout streambuf counting the write(2) calls. Like stdio on a
+  /// pipe it is fully buffered, and sync (std::endl) writes.
+  class CountingBuf : public std::streambuf
+  {
+  public:
+    CountingBuf()
+    : _buf( BUFSIZ )
+    { setp( _buf.data(), _buf.data() + _buf.size() ); }
+
+    unsigned writes() const
+    { return _writes; }
+
+  protected:
+    int_type overflow( int_type ch ) override
+    {
+      sync();
+      if ( ! traits_type::eq_int_type( ch, traits_type::eof() ) )
+	sputc( traits_type::to_char_type( ch ) );
+      return traits_type::not_eof( ch );
+    }
+
+    int sync() override
+    {
+      for ( const char * p = pbase(); p != pptr(); )
+      {
+	ssize_t n = ::write( STDOUT_FILENO, p, pptr() - p );
+	++_writes;
+	if ( n <= 0 )
+	  break;
+	p += n;
+      }
+      setp( _buf.data(), _buf.data() + _buf.size() );
+      return 0;
+    }
+
+  private:
+    std::vector<char> _buf;
+    unsigned _writes = 0;
+  };
+} // namespace
+
+int main( int argc, char * argv[] )
+{
+  bool buffered = ( argc > 1 && ::strcmp( argv[1], "--buffered" ) == 0 );
+  if ( buffered )
+  { --argc; ++argv; }
+  unsigned rows = ( argc > 1 ? std::stoul( argv[1] ) : 50000 );
+
+  CountingBuf & counting( *new CountingBuf );	// must outlive the static Out::bufferStdout buffer
+  std::cout.rdbuf( &counting );
+  if ( buffered )
+    Out::bufferStdout();
+
+  auto start = std::chrono::steady_clock::now();
+  std::cout << "<search-result version=\"0.0\">" << std::endl;
+  std::cout << "<solvable-list>" << std::endl;
+  for ( unsigned i = 0; i < rows; ++i )
+  {
+    std::cout << "<solvable status=\"not-installed\" name=\"package-" << i
+	      << "\" summary=\"Some package summary\" kind=\"package\"/>" << std::endl;
+  }
+  std::cout << "</solvable-list>" << std::endl;
+  std::cout << "</search-result>" << std::endl;
+  Out::flush();
+  auto stop = std::chrono::steady_clock::now();
+
+  std::cerr << ( buffered ? "buffered: " : "flush per line: " ) << rows << " rows, "
+	    << counting.writes() << " write(2) calls, "
+	    << std::chrono::duration<double,std::milli>( stop - start ).count() << " ms" << std::endl;
+  return 0;
+}
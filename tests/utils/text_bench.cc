@@ -0,0 +1,76 @@
+// Microbenchmark for the printable ASCII fast path in utils/text.h.
+// Not run by ctest: build target 'text_bench' and run it manually.
+#include <chrono>
+#include <clocale>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include "utils/text.h"
+
+namespace
+{
+  /** mbs_width as it was without the ASCII fast path. */
+  size_t iteratorWidth( boost::string_ref text_r )
+  {
+    size_t ret = 0;
+    for( mbs::MbsIterator it( text_r ); ! it.atEnd(); ++it )
+      ret += it.columns();
+    return ret;
+  }
+
+  /** Cells as found in 'zypper pa' / 'zypper se -s' tables. */
+  std::vector<std::string> tableCells( unsigned rows_r )
+  {
+    static const char * names[]    = { "libzypp", "zypper-log", "python3-setuptools", "kernel-default-devel", "libQt5Widgets5", "texlive-collection-langcjk", "glibc-locale-base" };
+    static const char * archs[]    = { "x86_64", "noarch", "i586" };
+    static const char * repos[]    = { "repo-oss", "repo-update", "Main Repository (OSS)", "Haupt-Repository (Übersicht)" };
+    static const char * status[]   = { "i+", "v", "", "i" };
+    static const char * summaries[]= { "Library for package, patch, pattern and product management", "Command line software manager using libzypp", "Écran de démarrage graphique", "日本語フォント" };
+
+    std::vector<std::string> ret;
+    ret.reserve( rows_r * 6 );
+    for ( unsigned i = 0; i < rows_r; ++i )
+    {
+      ret.push_back( status[i % 4] );
+      ret.push_back( repos[i % 4] );
+      ret.push_back( std::string( names[i % 7] ) + "-" + std::to_string( i ) );
+      ret.push_back( std::to_string( i % 30 ) + "." + std::to_string( i % 7 ) + "-150400." + std::to_string( i % 100 ) + ".1" );
+      ret.push_back( archs[i % 3] );
+      ret.push_back( summaries[i % 4] );
+    }
+    return ret;
+  }
+
+  template <class TFnc>
+  void bench( const char * label_r, const std::vector<std::string> & cells_r, TFnc && fnc_r )
+  {
+    using clock = std::chrono::steady_clock;
+    size_t sum = 0;
+    clock::time_point start = clock::now();
+    for ( unsigned round = 0; round < 10; ++round )
+      for ( const std::string & cell : cells_r )
+	sum += fnc_r( cell );
+    double ns = std::chrono::duration<double,std::nano>( clock::now() - start ).count() / ( 10 * cells_r.size() );
+    std::cout << label_r << ": " << ns << " ns/cell (" << sum << ")" << std::endl;
+  }
+}
+
+int main()
+{
+  ::setlocale( LC_CTYPE, "en_US.UTF-8" );
+  const std::vector<std::string> cells( tableCells( 60000 ) );
+
+  bench( "MbsIterator width      ", cells, []( const std::string & s ) { return iteratorWidth( s ); } );
+  bench( "mbs_width              ", cells, []( const std::string & s ) { return mbs_width( s ); } );
+  bench( "mbs_substr_by_width(12)", cells, []( const std::string & s ) { return mbs_substr_by_width( s, 0, 12 ).size(); } );
+
+  std::ostringstream out;
+  bench( "MbsWriteWrapped        ", cells, [&out]( const std::string & s ) {
+    out.str( "" );
+    mbs::MbsWriteWrapped mww( out, 4, 40 );
+    mww.writePar( s );
+    return size_t(out.tellp());
+  } );
+  return 0;
+}
@@ -168,3 +168,45 @@ BOOST_AUTO_TEST_CASE(mbs_iterator)
   BOOST_CHECK_EQUAL( *it,		L'\0' );	// stays at end
   BOOST_CHECK_EQUAL( it.atEnd(),	true );
 }
+
+BOOST_AUTO_TEST_CASE(mbs_printable_ascii_prefix)
+{
+  BOOST_CHECK_EQUAL( mbs::printableAsciiPrefix( "" ),	0 );
+  // the vectorized scan must find the 1st non printable byte at any position
+  for ( unsigned len = 1; len < 40; ++len )
+  {
+    for ( unsigned pos = 0; pos < len; ++pos )
+    {
+      for ( char bad : { '\t', '\033', '\177', '\200', '\303' } )
+      {
+	std::string s( len, 'x' );
+	s[pos] = bad;
+	BOOST_CHECK_EQUAL( mbs::printableAsciiPrefix( s ), pos );
+      }
+    }
+    BOOST_CHECK_EQUAL( mbs::printableAsciiPrefix( std::string( len, '~' ) ), len );
+    BOOST_CHECK_EQUAL( mbs_is_printable_ascii( std::string( len, ' ' ) ), true );
+  }
+}
+
+BOOST_AUTO_TEST_CASE(mbs_width_ascii_fast_path)
+{
+  cout << "locale set to: " << setlocale (LC_CTYPE, "en_US.UTF-8") << endl;
+  Zypper::instance().configNoConst().do_colors = true;
+  // ASCII runs mixed with multi-byte chars, controls and SGR
+  for ( const std::string & s : { std::string("libzypp-17.31.8-150400.3.32.1.x86_64"),
+				  std::string("Koľko stĺpcov zaberajú znaky '和平'?"),
+				  ColorString( "0123456789abcdef'和\t平'0123456789abcdef", ColorContext::NEGATIVE ).str() } )
+  {
+    size_t width = 0;
+    for( mbs::MbsIterator it( s ); ! it.atEnd(); ++it )
+      width += it.columns();
+    BOOST_CHECK_EQUAL( mbs_width( s ), width );
+  }
+
+  std::string s = "0123456789abcdef玄米茶";
+  BOOST_CHECK_EQUAL( mbs_substr_by_width( s, 2, 6 ),	"234567" );
+  BOOST_CHECK_EQUAL( mbs_substr_by_width( s, 14, 4 ),	"ef玄" );
+  BOOST_CHECK_EQUAL( mbs_substr_by_width( s, 15, 2 ),	"f " );
+  BOOST_CHECK_EQUAL( mbs_substr_by_width( "abc", 5, 2 ),	"" );
+}